@@ -7,44 +7,46 @@
 // B out = B in + A in
 
 #ifdef ARDUINO_SAM_DUE
-    MIDI_CREATE_INSTANCE(HardwareSerial, Serial,     midiA);
-    MIDI_CREATE_INSTANCE(HardwareSerial, Serial1,    midiB);
+    typedef HardwareSerial SerialA;
+    typedef HardwareSerial SerialB;
+    #define SERIAL_A Serial
+    #define SERIAL_B Serial1
 #elif defined(ARDUINO_SAMD_ZERO)
-    MIDI_CREATE_INSTANCE(HardwareSerial, SerialUSB,  midiA);
-    MIDI_CREATE_INSTANCE(HardwareSerial, Serial1,    midiB);
+    typedef HardwareSerial SerialA;
+    typedef HardwareSerial SerialB;
+    #define SERIAL_A SerialUSB
+    #define SERIAL_B Serial1
 #else
     #include <SoftwareSerial.h>
     SoftwareSerial softSerial(2,3);
-    MIDI_CREATE_INSTANCE(HardwareSerial, Serial,     midiA);
-    MIDI_CREATE_INSTANCE(SoftwareSerial, softSerial, midiB);
+    typedef HardwareSerial SerialA;
+    typedef SoftwareSerial SerialB;
+    #define SERIAL_A Serial
+    #define SERIAL_B softSerial
 #endif
 
+MIDI_CREATE_INSTANCE(SerialA, SERIAL_A, midiA);
+MIDI_CREATE_INSTANCE(SerialB, SERIAL_B, midiB);
+
+// Thru on each input also writes to the other output.
+// Messages are encoded once and written to both outputs.
+// The interfaces do not see these bytes on their port, so they must not use
+// Running Status (off in the default settings).
+midi::SerialThruOutput<SerialB> thruAtoB((SerialB&)SERIAL_B);
+midi::SerialThruOutput<SerialA> thruBtoA((SerialA&)SERIAL_A);
+
 void setup()
 {
     // Initiate MIDI communications, listen to all channels
     midiA.begin(MIDI_CHANNEL_OMNI);
     midiB.begin(MIDI_CHANNEL_OMNI);
+
+    midiA.addThruOutput(thruAtoB);
+    midiB.addThruOutput(thruBtoA);
 }
 
 void loop()
 {
-    if (midiA.read())
-    {
-        // Thru on A has already pushed the input message to out A.
-        // Forward the message to out B as well.
-        midiB.send(midiA.getType(),
-                   midiA.getData1(),
-                   midiA.getData2(),
-                   midiA.getChannel());
-    }
-
-    if (midiB.read())
-    {
-        // Thru on B has already pushed the input message to out B.
-        // Forward the message to out A as well.
-        midiA.send(midiB.getType(),
-                   midiB.getData1(),
-                   midiB.getData2(),
-                   midiB.getChannel());
-    }
+    midiA.read();
+    midiB.read();
 }
@@ -31,6 +31,47 @@
 
 BEGIN_MIDI_NAMESPACE
 
+#define MIDI_STATUS_CHANNEL_2B  (2 | StatusTable::Defined | StatusTable::ChannelMessage)
+#define MIDI_STATUS_CHANNEL_3B  (3 | StatusTable::Defined | StatusTable::ChannelMessage)
+#define MIDI_STATUS_REALTIME    (1 | StatusTable::Defined | StatusTable::RealTime)
+
+const byte StatusTable::sFlags[32] = {
+    // 0x00 - 0x7f: data bytes
+    0, 0, 0, 0, 0, 0, 0, 0,
+
+    MIDI_STATUS_CHANNEL_3B,         // 0x8n NoteOff
+    MIDI_STATUS_CHANNEL_3B,         // 0x9n NoteOn
+    MIDI_STATUS_CHANNEL_3B,         // 0xAn AfterTouchPoly
+    MIDI_STATUS_CHANNEL_3B,         // 0xBn ControlChange
+    MIDI_STATUS_CHANNEL_2B,         // 0xCn ProgramChange
+    MIDI_STATUS_CHANNEL_2B,         // 0xDn AfterTouchChannel
+    MIDI_STATUS_CHANNEL_3B,         // 0xEn PitchBend
+    0,                              // 0xFn: see below
+
+    0 | StatusTable::Defined,       // 0xF0 SystemExclusive (any length)
+    2 | StatusTable::Defined,       // 0xF1 TimeCodeQuarterFrame
+    3 | StatusTable::Defined,       // 0xF2 SongPosition
+    2 | StatusTable::Defined,       // 0xF3 SongSelect
+    0,                              // 0xF4 Undefined
+    0,                              // 0xF5 Undefined
+    1 | StatusTable::Defined,       // 0xF6 TuneRequest
+    0,                              // 0xF7 End of Exclusive (does not start a message)
+    MIDI_STATUS_REALTIME,           // 0xF8 Clock
+    0,                              // 0xF9 Undefined
+    MIDI_STATUS_REALTIME,           // 0xFA Start
+    MIDI_STATUS_REALTIME,           // 0xFB Continue
+    MIDI_STATUS_REALTIME,           // 0xFC Stop
+    0,                              // 0xFD Undefined
+    MIDI_STATUS_REALTIME,           // 0xFE ActiveSensing
+    MIDI_STATUS_REALTIME,           // 0xFF SystemReset
+};
+
+#undef MIDI_STATUS_CHANNEL_2B
+#undef MIDI_STATUS_CHANNEL_3B
+#undef MIDI_STATUS_REALTIME
+
+// -----------------------------------------------------------------------------
+
 /*! \brief Encode System Exclusive messages.
  SysEx messages are encoded to guarantee transmission of data bytes higher than
  127 without breaking the MIDI protocol. Use this static method to convert the
@@ -102,4 +143,65 @@ unsigned decodeSysEx(const byte* inSysEx, byte* outData, unsigned inLength)
     return count;
 }
 
+// -----------------------------------------------------------------------------
+
+SysExPool::SysExPool(byte* inStorage, unsigned inBlockSize, unsigned inBlockCount)
+    : mStorage(inStorage)
+    , mBlockSize(inBlockSize)
+    , mBlockCount(byte(inBlockCount))
+    , mBlocksInUse(0)
+    , mPeakBlocksInUse(0)
+    , mUsedMask(0)
+    , mExhaustionCount(0)
+{
+}
+
+/*! \brief Borrow a free block.
+ \return The block, or a null pointer when all blocks are in use.
+ */
+byte* SysExPool::acquire()
+{
+    for (byte i = 0; i < mBlockCount; ++i)
+    {
+        const unsigned long bit = 1ul << i;
+        if (!(mUsedMask & bit))
+        {
+            mUsedMask |= bit;
+            if (++mBlocksInUse > mPeakBlocksInUse)
+            {
+                mPeakBlocksInUse = mBlocksInUse;
+            }
+            return mStorage + unsigned(i) * mBlockSize;
+        }
+    }
+    mExhaustionCount++;
+    return 0;
+}
+
+/*! \brief Give back a block obtained with acquire(). */
+void SysExPool::release(byte* inBlock)
+{
+    if (inBlock < mStorage)
+    {
+        return; // Not one of ours.
+    }
+    const unsigned index = unsigned(inBlock - mStorage) / mBlockSize;
+    if (index >= mBlockCount)
+    {
+        return;
+    }
+    const unsigned long bit = 1ul << index;
+    if (mUsedMask & bit)
+    {
+        mUsedMask &= ~bit;
+        mBlocksInUse--;
+    }
+}
+
+void SysExPool::resetCounters()
+{
+    mPeakBlocksInUse = mBlocksInUse;
+    mExhaustionCount = 0;
+}
+
 END_MIDI_NAMESPACE
@@ -29,7 +29,15 @@
 
 #include "midi_Defs.h"
 #include "midi_Settings.h"
+#include "midi_Platform.h"
 #include "midi_Message.h"
+#include "midi_StatusTable.h"
+#include "midi_MessageQueue.h"
+#include "midi_OutputBuffer.h"
+#include "midi_Statistics.h"
+#include "midi_SysExPool.h"
+#include "midi_Handlers.h"
+#include "midi_ThruOutput.h"
 
 // -----------------------------------------------------------------------------
 
@@ -40,12 +48,24 @@ It is templated over the type of serial port to provide abstraction from
 the hardware interface, meaning you can use HardwareSerial, SoftwareSerial
 or ak47's Uart classes. The only requirement is that the class implements
 the begin, read, write and available methods.
+Received messages are dispatched to the Handler policy: CallbackHandler
+calls the functions registered with setHandle..., StaticHandler resolves
+handlers at compile time (see midi_Handlers.h).
  */
-template<class SerialPort, class _Settings = DefaultSettings>
+template<class SerialPort,
+         class _Settings = DefaultSettings,
+         class _Platform = DefaultPlatform,
+         class _Handler  = CallbackHandler<Message<_Settings::SysExMaxSize, _Settings::UseReceiveTimestamps> > >
 class MidiInterface
+    : private _Handler
+    , private Statistics<_Settings::UseStatistics> // Empty base when compiled out.
 {
 public:
     typedef _Settings Settings;
+    typedef _Platform Platform;
+    typedef _Handler  Handler;
+    typedef Message<Settings::SysExMaxSize, Settings::UseReceiveTimestamps> MidiMessage;
+    typedef Statistics<Settings::UseStatistics> MidiStatistics;
 
 public:
     inline  MidiInterface(SerialPort& inSerial);
@@ -130,6 +150,13 @@ public:
               DataByte inData1,
               DataByte inData2,
               Channel inChannel);
+    void send(const MidiMessage* inMessages, unsigned inCount);
+    inline void flush();
+    inline unsigned long getRunningStatusSavings() const;
+
+private:
+    inline void transmit(byte inData);
+    inline void transmit(const byte* inData, unsigned inSize);
 
     // -------------------------------------------------------------------------
     // MIDI Input
@@ -137,6 +164,14 @@ public:
 public:
     inline bool read();
     inline bool read(Channel inChannel);
+    inline unsigned read(const byte* inData, unsigned inSize);
+    unsigned read(const byte* inData, unsigned inSize, Channel inChannel);
+    inline unsigned readMessages(unsigned inMaxMessages);
+    unsigned readMessages(unsigned inMaxMessages, Channel inChannel);
+    inline unsigned readFor(unsigned long inBudget);
+    unsigned readFor(unsigned long inBudget, Channel inChannel);
+    inline bool feed(byte inData);
+    bool feed(const byte* inData, unsigned inSize);
 
 public:
     inline MidiType getType() const;
@@ -145,12 +180,20 @@ public:
     inline DataByte getData2() const;
     inline const byte* getSysExArray() const;
     inline unsigned getSysExArrayLength() const;
+    inline unsigned long getTimestamp() const;
     inline bool check() const;
 
+public:
+    inline void setSysExPool(SysExPool* inPool);
+
 public:
     inline Channel getInputChannel() const;
     inline void setInputChannel(Channel inChannel);
 
+public:
+    inline MidiStatistics getStatistics() const;
+    inline void resetStatistics();
+
 public:
     static inline MidiType getTypeFromStatusByte(byte inStatus);
     static inline Channel getChannelFromStatusByte(byte inStatus);
@@ -160,48 +203,32 @@ public:
     // Input Callbacks
 
 public:
-    inline void setHandleNoteOff(void (*fptr)(byte channel, byte note, byte velocity));
-    inline void setHandleNoteOn(void (*fptr)(byte channel, byte note, byte velocity));
-    inline void setHandleAfterTouchPoly(void (*fptr)(byte channel, byte note, byte pressure));
-    inline void setHandleControlChange(void (*fptr)(byte channel, byte number, byte value));
-    inline void setHandleProgramChange(void (*fptr)(byte channel, byte number));
-    inline void setHandleAfterTouchChannel(void (*fptr)(byte channel, byte pressure));
-    inline void setHandlePitchBend(void (*fptr)(byte channel, int bend));
-    inline void setHandleSystemExclusive(void (*fptr)(byte * array, unsigned size));
-    inline void setHandleTimeCodeQuarterFrame(void (*fptr)(byte data));
-    inline void setHandleSongPosition(void (*fptr)(unsigned beats));
-    inline void setHandleSongSelect(void (*fptr)(byte songnumber));
-    inline void setHandleTuneRequest(void (*fptr)(void));
-    inline void setHandleClock(void (*fptr)(void));
-    inline void setHandleStart(void (*fptr)(void));
-    inline void setHandleContinue(void (*fptr)(void));
-    inline void setHandleStop(void (*fptr)(void));
-    inline void setHandleActiveSensing(void (*fptr)(void));
-    inline void setHandleSystemReset(void (*fptr)(void));
+    inline void setHandleMessage(Delegate<void(const MidiMessage& message)> inCallback);
+    inline void setHandleNoteOff(Delegate<void(byte channel, byte note, byte velocity)> inCallback);
+    inline void setHandleNoteOn(Delegate<void(byte channel, byte note, byte velocity)> inCallback);
+    inline void setHandleAfterTouchPoly(Delegate<void(byte channel, byte note, byte pressure)> inCallback);
+    inline void setHandleControlChange(Delegate<void(byte channel, byte number, byte value)> inCallback);
+    inline void setHandleProgramChange(Delegate<void(byte channel, byte number)> inCallback);
+    inline void setHandleAfterTouchChannel(Delegate<void(byte channel, byte pressure)> inCallback);
+    inline void setHandlePitchBend(Delegate<void(byte channel, int bend)> inCallback);
+    inline void setHandleSystemExclusive(Delegate<void(byte* array, unsigned size)> inCallback);
+    inline void setHandleSystemExclusiveChunk(Delegate<void(byte* array, unsigned size, byte flags)> inCallback);
+    inline void setHandleTimeCodeQuarterFrame(Delegate<void(byte data)> inCallback);
+    inline void setHandleSongPosition(Delegate<void(unsigned beats)> inCallback);
+    inline void setHandleSongSelect(Delegate<void(byte songnumber)> inCallback);
+    inline void setHandleTuneRequest(Delegate<void()> inCallback);
+    inline void setHandleClock(Delegate<void()> inCallback);
+    inline void setHandleStart(Delegate<void()> inCallback);
+    inline void setHandleContinue(Delegate<void()> inCallback);
+    inline void setHandleStop(Delegate<void()> inCallback);
+    inline void setHandleActiveSensing(Delegate<void()> inCallback);
+    inline void setHandleSystemReset(Delegate<void()> inCallback);
 
     inline void disconnectCallbackFromType(MidiType inType);
 
 private:
     void launchCallback();
-
-    void (*mNoteOffCallback)(byte channel, byte note, byte velocity);
-    void (*mNoteOnCallback)(byte channel, byte note, byte velocity);
-    void (*mAfterTouchPolyCallback)(byte channel, byte note, byte velocity);
-    void (*mControlChangeCallback)(byte channel, byte, byte);
-    void (*mProgramChangeCallback)(byte channel, byte);
-    void (*mAfterTouchChannelCallback)(byte channel, byte);
-    void (*mPitchBendCallback)(byte channel, int);
-    void (*mSystemExclusiveCallback)(byte * array, unsigned size);
-    void (*mTimeCodeQuarterFrameCallback)(byte data);
-    void (*mSongPositionCallback)(unsigned beats);
-    void (*mSongSelectCallback)(byte songnumber);
-    void (*mTuneRequestCallback)(void);
-    void (*mClockCallback)(void);
-    void (*mStartCallback)(void);
-    void (*mContinueCallback)(void);
-    void (*mStopCallback)(void);
-    void (*mActiveSensingCallback)(void);
-    void (*mSystemResetCallback)(void);
+    inline byte getSysExChunkFlags() const;
 
     // -------------------------------------------------------------------------
     // MIDI Soft Thru
@@ -214,17 +241,39 @@ public:
     inline void turnThruOff();
     inline void setThruFilterMode(Thru::Mode inThruFilterMode);
 
+public:
+    inline void addThruOutput(ThruOutput& inOutput);
+    inline void removeThruOutput(ThruOutput& inOutput);
+
 private:
     void thruFilter(byte inChannel);
+    void thruToOutputs(const byte* inData, unsigned inSize, byte inStatus, Channel inChannel);
+    static inline bool isThruAccepted(Thru::Mode inMode, byte inStatus, Channel inChannel);
+    inline void thruStatus(byte inStatus);
+    inline void thruData(byte inData);
+    inline void thruRealTime(byte inData);
 
 private:
     bool parse();
+    void enqueue();
+    bool parseByte(byte inData);
+    inline bool processMessage(Channel inChannel);
+    inline bool pushMessage();
+    template<bool UseBudget>
+    unsigned drain(Channel inChannel,
+                   unsigned inMaxMessages,
+                   unsigned long inBudget);
+    void handleRealTime(byte inData);
     inline void handleNullVelocityNoteOnAsNoteOff();
     inline bool inputFilter(Channel inChannel);
     inline void resetInput();
+    inline byte* getSysExPayload();
+    inline void releaseHandledSysExBlock();
+    inline void releaseSysExBlock();
 
 private:
-    typedef Message<Settings::SysExMaxSize> MidiMessage;
+    typedef MessageQueue<MidiMessage, Settings::MessageQueueSize> MidiMessageQueue;
+    typedef OutputBuffer<Settings::OutputBufferSize> MidiOutputBuffer;
 
 private:
     SerialPort& mSerial;
@@ -233,14 +282,25 @@ private:
     Channel         mInputChannel;
     StatusByte      mRunningStatus_RX;
     StatusByte      mRunningStatus_TX;
+    unsigned long   mRunningStatusSavings;
     byte            mPendingMessage[3];
     unsigned        mPendingMessageExpectedLenght;
     unsigned        mPendingMessageIndex;
+    unsigned        mSysExChunkLength;
+    MessageTimestamp<Settings::UseReceiveTimestamps> mPendingTime;
     unsigned        mCurrentRpnNumber;
     unsigned        mCurrentNrpnNumber;
     bool            mThruActivated  : 1;
     Thru::Mode      mThruFilterMode : 7;
+    bool            mThruForwarding;
+    ThruOutput*     mThruOutputs;
     MidiMessage     mMessage;
+    MidiMessageQueue mMessageQueue;
+    MidiOutputBuffer mOutputBuffer;
+    SysExPool*      mSysExPool;
+    SysExPool*      mSysExBlockPool;
+    byte*           mSysExBlock;
+    bool            mMessageHeld;
 
 
 private:
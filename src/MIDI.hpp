@@ -30,45 +30,35 @@
 BEGIN_MIDI_NAMESPACE
 
 /// \brief Constructor for MidiInterface.
-template<class SerialPort, class Settings>
-inline MidiInterface<SerialPort, Settings>::MidiInterface(SerialPort& inSerial)
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline MidiInterface<SerialPort, Settings, Platform, Handler>::MidiInterface(SerialPort& inSerial)
     : mSerial(inSerial)
     , mInputChannel(0)
     , mRunningStatus_RX(InvalidType)
     , mRunningStatus_TX(InvalidType)
+    , mRunningStatusSavings(0)
     , mPendingMessageExpectedLenght(0)
     , mPendingMessageIndex(0)
+    , mSysExChunkLength(0)
     , mCurrentRpnNumber(0xffff)
     , mCurrentNrpnNumber(0xffff)
     , mThruActivated(true)
     , mThruFilterMode(Thru::Full)
+    , mThruForwarding(false)
+    , mThruOutputs(0)
+    , mSysExPool(0)
+    , mSysExBlockPool(0)
+    , mSysExBlock(0)
+    , mMessageHeld(false)
 {
-    mNoteOffCallback                = 0;
-    mNoteOnCallback                 = 0;
-    mAfterTouchPolyCallback         = 0;
-    mControlChangeCallback          = 0;
-    mProgramChangeCallback          = 0;
-    mAfterTouchChannelCallback      = 0;
-    mPitchBendCallback              = 0;
-    mSystemExclusiveCallback        = 0;
-    mTimeCodeQuarterFrameCallback   = 0;
-    mSongPositionCallback           = 0;
-    mSongSelectCallback             = 0;
-    mTuneRequestCallback            = 0;
-    mClockCallback                  = 0;
-    mStartCallback                  = 0;
-    mContinueCallback               = 0;
-    mStopCallback                   = 0;
-    mActiveSensingCallback          = 0;
-    mSystemResetCallback            = 0;
 }
 
 /*! \brief Destructor for MidiInterface.
 
  This is not really useful for the Arduino, as it is never called...
  */
-template<class SerialPort, class Settings>
-inline MidiInterface<SerialPort, Settings>::~MidiInterface()
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline MidiInterface<SerialPort, Settings, Platform, Handler>::~MidiInterface()
 {
 }
 
@@ -80,8 +70,8 @@ inline MidiInterface<SerialPort, Settings>::~MidiInterface()
  - Input channel set to 1 if no value is specified
  - Full thru mirroring
  */
-template<class SerialPort, class Settings>
-void MidiInterface<SerialPort, Settings>::begin(Channel inChannel)
+template<class SerialPort, class Settings, class Platform, class Handler>
+void MidiInterface<SerialPort, Settings, Platform, Handler>::begin(Channel inChannel)
 {
     // Initialise the Serial port
 #if defined(AVR_CAKE)
@@ -92,10 +82,16 @@ void MidiInterface<SerialPort, Settings>::begin(Channel inChannel)
 
     mInputChannel = inChannel;
     mRunningStatus_TX = InvalidType;
+    mRunningStatusSavings = 0;
     mRunningStatus_RX = InvalidType;
 
     mPendingMessageIndex = 0;
     mPendingMessageExpectedLenght = 0;
+    mMessageHeld = false;
+    mMessageQueue.clear();
+    mOutputBuffer.clear();
+    releaseSysExBlock();
+    MidiStatistics::reset();
 
     mCurrentRpnNumber  = 0xffff;
     mCurrentNrpnNumber = 0xffff;
@@ -107,6 +103,7 @@ void MidiInterface<SerialPort, Settings>::begin(Channel inChannel)
     mMessage.data2   = 0;
 
     mThruFilterMode = Thru::Full;
+    mThruForwarding = false;
     mThruActivated  = true;
 }
 
@@ -129,8 +126,8 @@ void MidiInterface<SerialPort, Settings>::begin(Channel inChannel)
  This is an internal method, use it only if you need to send raw data
  from your code, at your own risks.
  */
-template<class SerialPort, class Settings>
-void MidiInterface<SerialPort, Settings>::send(MidiType inType,
+template<class SerialPort, class Settings, class Platform, class Handler>
+void MidiInterface<SerialPort, Settings, Platform, Handler>::send(MidiType inType,
                                                DataByte inData1,
                                                DataByte inData2,
                                                Channel inChannel)
@@ -149,6 +146,14 @@ void MidiInterface<SerialPort, Settings>::send(MidiType inType,
         inData1 &= 0x7f;
         inData2 &= 0x7f;
 
+        if (Settings::UseRunningStatus && Settings::SendNoteOffAsNullVelocityNoteOn &&
+            inType == NoteOff && (inData2 == 0 || inData2 == 64))
+        {
+            // No release velocity to lose, share the NoteOn status.
+            inType  = NoteOn;
+            inData2 = 0;
+        }
+
         const StatusByte status = getStatus(inType, inChannel);
 
         if (Settings::UseRunningStatus)
@@ -157,20 +162,29 @@ void MidiInterface<SerialPort, Settings>::send(MidiType inType,
             {
                 // New message, memorise and send header
                 mRunningStatus_TX = status;
-                mSerial.write(mRunningStatus_TX);
+                transmit(mRunningStatus_TX);
+            }
+            else
+            {
+                mRunningStatusSavings++;
             }
         }
         else
         {
             // Don't care about running status, send the status byte.
-            mSerial.write(status);
+            transmit(status);
+            if (Settings::UseCutThroughThru)
+            {
+                // Cut-through Thru needs to know the status seen by the output.
+                mRunningStatus_TX = status;
+            }
         }
 
         // Then send data
-        mSerial.write(inData1);
+        transmit(inData1);
         if (inType != ProgramChange && inType != AfterTouchChannel)
         {
-            mSerial.write(inData2);
+            transmit(inData2);
         }
     }
     else if (inType >= Clock && inType <= SystemReset)
@@ -179,6 +193,89 @@ void MidiInterface<SerialPort, Settings>::send(MidiType inType,
     }
 }
 
+/*! \brief Send a list of messages, then flush the output.
+
+ With DefaultSettings::OutputBufferSize, the messages are written to the port
+ with as few calls as possible (a single one when they fit in the buffer).
+ SysEx messages must include their 0xf0 and 0xf7 boundaries, as received.
+ \param inMessages The messages to send.
+ \param inCount    The number of messages.
+ */
+template<class SerialPort, class Settings, class Platform, class Handler>
+void MidiInterface<SerialPort, Settings, Platform, Handler>::send(const MidiMessage* inMessages,
+                                                                unsigned inCount)
+{
+    for (unsigned i = 0; i < inCount; ++i)
+    {
+        const MidiMessage& message = inMessages[i];
+        switch (message.type)
+        {
+            case SystemExclusive:
+                sendSysEx(message.getSysExSize(), message.sysexArray, true);
+                break;
+            case TimeCodeQuarterFrame:
+                sendTimeCodeQuarterFrame(message.data1);
+                break;
+            case SongPosition:
+                sendSongPosition(unsigned(message.data2) << 7 | message.data1);
+                break;
+            case SongSelect:
+                sendSongSelect(message.data1);
+                break;
+            case TuneRequest:
+                sendTuneRequest();
+                break;
+            case Clock:
+            case Start:
+            case Continue:
+            case Stop:
+            case ActiveSensing:
+            case SystemReset:
+                sendRealTime(message.type);
+                break;
+            default:
+                send(message.type, message.data1, message.data2, message.channel);
+                break;
+        }
+    }
+    flush();
+}
+
+/*! \brief Write the buffered output bytes to the port.
+
+ Does nothing unless DefaultSettings::OutputBufferSize is enabled.
+ */
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline void MidiInterface<SerialPort, Settings, Platform, Handler>::flush()
+{
+    mOutputBuffer.flush(mSerial);
+}
+
+/*! \brief Number of status bytes omitted thanks to Running Status since
+ begin(), on sent and Thru messages.
+ @see DefaultSettings::UseRunningStatus
+ */
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline unsigned long MidiInterface<SerialPort, Settings, Platform, Handler>::getRunningStatusSavings() const
+{
+    return mRunningStatusSavings;
+}
+
+// Private method: write a byte to the port, through the output buffer.
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline void MidiInterface<SerialPort, Settings, Platform, Handler>::transmit(byte inData)
+{
+    mOutputBuffer.write(mSerial, inData);
+}
+
+// Private method: write bytes to the port, through the output buffer.
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline void MidiInterface<SerialPort, Settings, Platform, Handler>::transmit(const byte* inData,
+                                                                           unsigned inSize)
+{
+    mOutputBuffer.write(mSerial, inData, inSize);
+}
+
 // -----------------------------------------------------------------------------
 
 /*! \brief Send a Note On message
@@ -190,8 +287,8 @@ void MidiInterface<SerialPort, Settings>::send(MidiType inType,
  Take a look at the values, names and frequencies of notes here:
  http://www.phys.unsw.edu.au/jw/notes.html
  */
-template<class SerialPort, class Settings>
-void MidiInterface<SerialPort, Settings>::sendNoteOn(DataByte inNoteNumber,
+template<class SerialPort, class Settings, class Platform, class Handler>
+void MidiInterface<SerialPort, Settings, Platform, Handler>::sendNoteOn(DataByte inNoteNumber,
                                                      DataByte inVelocity,
                                                      Channel inChannel)
 {
@@ -209,8 +306,8 @@ void MidiInterface<SerialPort, Settings>::sendNoteOn(DataByte inNoteNumber,
  Take a look at the values, names and frequencies of notes here:
  http://www.phys.unsw.edu.au/jw/notes.html
  */
-template<class SerialPort, class Settings>
-void MidiInterface<SerialPort, Settings>::sendNoteOff(DataByte inNoteNumber,
+template<class SerialPort, class Settings, class Platform, class Handler>
+void MidiInterface<SerialPort, Settings, Platform, Handler>::sendNoteOff(DataByte inNoteNumber,
                                                       DataByte inVelocity,
                                                       Channel inChannel)
 {
@@ -221,8 +318,8 @@ void MidiInterface<SerialPort, Settings>::sendNoteOff(DataByte inNoteNumber,
  \param inProgramNumber The Program to select (0 to 127).
  \param inChannel       The channel on which the message will be sent (1 to 16).
  */
-template<class SerialPort, class Settings>
-void MidiInterface<SerialPort, Settings>::sendProgramChange(DataByte inProgramNumber,
+template<class SerialPort, class Settings, class Platform, class Handler>
+void MidiInterface<SerialPort, Settings, Platform, Handler>::sendProgramChange(DataByte inProgramNumber,
                                                             Channel inChannel)
 {
     send(ProgramChange, inProgramNumber, 0, inChannel);
@@ -234,8 +331,8 @@ void MidiInterface<SerialPort, Settings>::sendProgramChange(DataByte inProgramNu
  \param inChannel       The channel on which the message will be sent (1 to 16).
  @see MidiControlChangeNumber
  */
-template<class SerialPort, class Settings>
-void MidiInterface<SerialPort, Settings>::sendControlChange(DataByte inControlNumber,
+template<class SerialPort, class Settings, class Platform, class Handler>
+void MidiInterface<SerialPort, Settings, Platform, Handler>::sendControlChange(DataByte inControlNumber,
                                                             DataByte inControlValue,
                                                             Channel inChannel)
 {
@@ -249,8 +346,8 @@ void MidiInterface<SerialPort, Settings>::sendControlChange(DataByte inControlNu
  Note: this method is deprecated and will be removed in a future revision of the
  library, @see sendAfterTouch to send polyphonic and monophonic AfterTouch messages.
  */
-template<class SerialPort, class Settings>
-void MidiInterface<SerialPort, Settings>::sendPolyPressure(DataByte inNoteNumber,
+template<class SerialPort, class Settings, class Platform, class Handler>
+void MidiInterface<SerialPort, Settings, Platform, Handler>::sendPolyPressure(DataByte inNoteNumber,
                                                            DataByte inPressure,
                                                            Channel inChannel)
 {
@@ -261,8 +358,8 @@ void MidiInterface<SerialPort, Settings>::sendPolyPressure(DataByte inNoteNumber
  \param inPressure    The amount of AfterTouch to apply to all notes.
  \param inChannel     The channel on which the message will be sent (1 to 16).
  */
-template<class SerialPort, class Settings>
-void MidiInterface<SerialPort, Settings>::sendAfterTouch(DataByte inPressure,
+template<class SerialPort, class Settings, class Platform, class Handler>
+void MidiInterface<SerialPort, Settings, Platform, Handler>::sendAfterTouch(DataByte inPressure,
                                                          Channel inChannel)
 {
     send(AfterTouchChannel, inPressure, 0, inChannel);
@@ -274,8 +371,8 @@ void MidiInterface<SerialPort, Settings>::sendAfterTouch(DataByte inPressure,
  \param inChannel     The channel on which the message will be sent (1 to 16).
  @see Replaces sendPolyPressure (which is now deprecated).
  */
-template<class SerialPort, class Settings>
-void MidiInterface<SerialPort, Settings>::sendAfterTouch(DataByte inNoteNumber,
+template<class SerialPort, class Settings, class Platform, class Handler>
+void MidiInterface<SerialPort, Settings, Platform, Handler>::sendAfterTouch(DataByte inNoteNumber,
                                                          DataByte inPressure,
                                                          Channel inChannel)
 {
@@ -288,8 +385,8 @@ void MidiInterface<SerialPort, Settings>::sendAfterTouch(DataByte inNoteNumber,
  center value is 0.
  \param inChannel     The channel on which the message will be sent (1 to 16).
  */
-template<class SerialPort, class Settings>
-void MidiInterface<SerialPort, Settings>::sendPitchBend(int inPitchValue,
+template<class SerialPort, class Settings, class Platform, class Handler>
+void MidiInterface<SerialPort, Settings, Platform, Handler>::sendPitchBend(int inPitchValue,
                                                         Channel inChannel)
 {
     const unsigned bend = inPitchValue - MIDI_PITCHBEND_MIN;
@@ -303,8 +400,8 @@ void MidiInterface<SerialPort, Settings>::sendPitchBend(int inPitchValue,
  and +1.0f (max upwards bend), center value is 0.0f.
  \param inChannel     The channel on which the message will be sent (1 to 16).
  */
-template<class SerialPort, class Settings>
-void MidiInterface<SerialPort, Settings>::sendPitchBend(double inPitchValue,
+template<class SerialPort, class Settings, class Platform, class Handler>
+void MidiInterface<SerialPort, Settings, Platform, Handler>::sendPitchBend(double inPitchValue,
                                                         Channel inChannel)
 {
     const int scale = inPitchValue > 0.0 ? MIDI_PITCHBEND_MAX : MIDI_PITCHBEND_MIN;
@@ -321,8 +418,8 @@ void MidiInterface<SerialPort, Settings>::sendPitchBend(double inPitchValue,
  default value for ArrayContainsBoundaries is set to 'false' for compatibility
  with previous versions of the library.
  */
-template<class SerialPort, class Settings>
-void MidiInterface<SerialPort, Settings>::sendSysEx(unsigned inLength,
+template<class SerialPort, class Settings, class Platform, class Handler>
+void MidiInterface<SerialPort, Settings, Platform, Handler>::sendSysEx(unsigned inLength,
                                                     const byte* inArray,
                                                     bool inArrayContainsBoundaries)
 {
@@ -330,20 +427,17 @@ void MidiInterface<SerialPort, Settings>::sendSysEx(unsigned inLength,
 
     if (writeBeginEndBytes)
     {
-        mSerial.write(0xf0);
+        transmit(0xf0);
     }
 
-    for (unsigned i = 0; i < inLength; ++i)
-    {
-        mSerial.write(inArray[i]);
-    }
+    transmit(inArray, inLength);
 
     if (writeBeginEndBytes)
     {
-        mSerial.write(0xf7);
+        transmit(0xf7);
     }
 
-    if (Settings::UseRunningStatus)
+    if (Settings::UseRunningStatus || Settings::UseCutThroughThru)
     {
         mRunningStatus_TX = InvalidType;
     }
@@ -354,12 +448,12 @@ void MidiInterface<SerialPort, Settings>::sendSysEx(unsigned inLength,
  When a MIDI unit receives this message,
  it should tune its oscillators (if equipped with any).
  */
-template<class SerialPort, class Settings>
-void MidiInterface<SerialPort, Settings>::sendTuneRequest()
+template<class SerialPort, class Settings, class Platform, class Handler>
+void MidiInterface<SerialPort, Settings, Platform, Handler>::sendTuneRequest()
 {
-    mSerial.write(TuneRequest);
+    transmit(TuneRequest);
 
-    if (Settings::UseRunningStatus)
+    if (Settings::UseRunningStatus || Settings::UseCutThroughThru)
     {
         mRunningStatus_TX = InvalidType;
     }
@@ -371,8 +465,8 @@ void MidiInterface<SerialPort, Settings>::sendTuneRequest()
  \param inValuesNibble    MTC data
  See MIDI Specification for more information.
  */
-template<class SerialPort, class Settings>
-void MidiInterface<SerialPort, Settings>::sendTimeCodeQuarterFrame(DataByte inTypeNibble,
+template<class SerialPort, class Settings, class Platform, class Handler>
+void MidiInterface<SerialPort, Settings, Platform, Handler>::sendTimeCodeQuarterFrame(DataByte inTypeNibble,
                                                                    DataByte inValuesNibble)
 {
     const byte data = (((inTypeNibble & 0x07) << 4) | (inValuesNibble & 0x0f));
@@ -385,13 +479,13 @@ void MidiInterface<SerialPort, Settings>::sendTimeCodeQuarterFrame(DataByte inTy
  \param inData  if you want to encode directly the nibbles in your program,
                 you can send the byte here.
  */
-template<class SerialPort, class Settings>
-void MidiInterface<SerialPort, Settings>::sendTimeCodeQuarterFrame(DataByte inData)
+template<class SerialPort, class Settings, class Platform, class Handler>
+void MidiInterface<SerialPort, Settings, Platform, Handler>::sendTimeCodeQuarterFrame(DataByte inData)
 {
-    mSerial.write((byte)TimeCodeQuarterFrame);
-    mSerial.write(inData);
+    transmit((byte)TimeCodeQuarterFrame);
+    transmit(inData);
 
-    if (Settings::UseRunningStatus)
+    if (Settings::UseRunningStatus || Settings::UseCutThroughThru)
     {
         mRunningStatus_TX = InvalidType;
     }
@@ -400,27 +494,27 @@ void MidiInterface<SerialPort, Settings>::sendTimeCodeQuarterFrame(DataByte inDa
 /*! \brief Send a Song Position Pointer message.
  \param inBeats    The number of beats since the start of the song.
  */
-template<class SerialPort, class Settings>
-void MidiInterface<SerialPort, Settings>::sendSongPosition(unsigned inBeats)
+template<class SerialPort, class Settings, class Platform, class Handler>
+void MidiInterface<SerialPort, Settings, Platform, Handler>::sendSongPosition(unsigned inBeats)
 {
-    mSerial.write((byte)SongPosition);
-    mSerial.write(inBeats & 0x7f);
-    mSerial.write((inBeats >> 7) & 0x7f);
+    transmit((byte)SongPosition);
+    transmit(inBeats & 0x7f);
+    transmit((inBeats >> 7) & 0x7f);
 
-    if (Settings::UseRunningStatus)
+    if (Settings::UseRunningStatus || Settings::UseCutThroughThru)
     {
         mRunningStatus_TX = InvalidType;
     }
 }
 
 /*! \brief Send a Song Select message */
-template<class SerialPort, class Settings>
-void MidiInterface<SerialPort, Settings>::sendSongSelect(DataByte inSongNumber)
+template<class SerialPort, class Settings, class Platform, class Handler>
+void MidiInterface<SerialPort, Settings, Platform, Handler>::sendSongSelect(DataByte inSongNumber)
 {
-    mSerial.write((byte)SongSelect);
-    mSerial.write(inSongNumber & 0x7f);
+    transmit((byte)SongSelect);
+    transmit(inSongNumber & 0x7f);
 
-    if (Settings::UseRunningStatus)
+    if (Settings::UseRunningStatus || Settings::UseCutThroughThru)
     {
         mRunningStatus_TX = InvalidType;
     }
@@ -432,8 +526,8 @@ void MidiInterface<SerialPort, Settings>::sendSongSelect(DataByte inSongNumber)
  Start, Stop, Continue, Clock, ActiveSensing and SystemReset.
  @see MidiType
  */
-template<class SerialPort, class Settings>
-void MidiInterface<SerialPort, Settings>::sendRealTime(MidiType inType)
+template<class SerialPort, class Settings, class Platform, class Handler>
+void MidiInterface<SerialPort, Settings, Platform, Handler>::sendRealTime(MidiType inType)
 {
     // Do not invalidate Running Status for real-time messages
     // as they can be interleaved within any message.
@@ -446,7 +540,7 @@ void MidiInterface<SerialPort, Settings>::sendRealTime(MidiType inType)
         case Continue:
         case ActiveSensing:
         case SystemReset:
-            mSerial.write((byte)inType);
+            transmit((byte)inType);
             break;
         default:
             // Invalid Real Time marker
@@ -458,8 +552,8 @@ void MidiInterface<SerialPort, Settings>::sendRealTime(MidiType inType)
  \param inNumber The 14-bit number of the RPN you want to select.
  \param inChannel The channel on which the message will be sent (1 to 16).
 */
-template<class SerialPort, class Settings>
-inline void MidiInterface<SerialPort, Settings>::beginRpn(unsigned inNumber,
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline void MidiInterface<SerialPort, Settings, Platform, Handler>::beginRpn(unsigned inNumber,
                                                           Channel inChannel)
 {
     if (mCurrentRpnNumber != inNumber)
@@ -476,8 +570,8 @@ inline void MidiInterface<SerialPort, Settings>::beginRpn(unsigned inNumber,
  \param inValue  The 14-bit value of the selected RPN.
  \param inChannel The channel on which the message will be sent (1 to 16).
 */
-template<class SerialPort, class Settings>
-inline void MidiInterface<SerialPort, Settings>::sendRpnValue(unsigned inValue,
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline void MidiInterface<SerialPort, Settings, Platform, Handler>::sendRpnValue(unsigned inValue,
                                                               Channel inChannel)
 {;
     const byte valMsb = 0x7f & (inValue >> 7);
@@ -491,8 +585,8 @@ inline void MidiInterface<SerialPort, Settings>::sendRpnValue(unsigned inValue,
  \param inLsb The LSB part of the value to send. Meaning depends on RPN number.
  \param inChannel The channel on which the message will be sent (1 to 16).
 */
-template<class SerialPort, class Settings>
-inline void MidiInterface<SerialPort, Settings>::sendRpnValue(byte inMsb,
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline void MidiInterface<SerialPort, Settings, Platform, Handler>::sendRpnValue(byte inMsb,
                                                               byte inLsb,
                                                               Channel inChannel)
 {
@@ -503,8 +597,8 @@ inline void MidiInterface<SerialPort, Settings>::sendRpnValue(byte inMsb,
 /* \brief Increment the value of the currently selected RPN number by the specified amount.
  \param inAmount The amount to add to the currently selected RPN value.
 */
-template<class SerialPort, class Settings>
-inline void MidiInterface<SerialPort, Settings>::sendRpnIncrement(byte inAmount,
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline void MidiInterface<SerialPort, Settings, Platform, Handler>::sendRpnIncrement(byte inAmount,
                                                                   Channel inChannel)
 {
     sendControlChange(DataIncrement, inAmount, inChannel);
@@ -513,8 +607,8 @@ inline void MidiInterface<SerialPort, Settings>::sendRpnIncrement(byte inAmount,
 /* \brief Decrement the value of the currently selected RPN number by the specified amount.
  \param inAmount The amount to subtract to the currently selected RPN value.
 */
-template<class SerialPort, class Settings>
-inline void MidiInterface<SerialPort, Settings>::sendRpnDecrement(byte inAmount,
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline void MidiInterface<SerialPort, Settings, Platform, Handler>::sendRpnDecrement(byte inAmount,
                                                                   Channel inChannel)
 {
     sendControlChange(DataDecrement, inAmount, inChannel);
@@ -524,8 +618,8 @@ inline void MidiInterface<SerialPort, Settings>::sendRpnDecrement(byte inAmount,
 This will send a Null Function to deselect the currently selected RPN.
  \param inChannel The channel on which the message will be sent (1 to 16).
 */
-template<class SerialPort, class Settings>
-inline void MidiInterface<SerialPort, Settings>::endRpn(Channel inChannel)
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline void MidiInterface<SerialPort, Settings, Platform, Handler>::endRpn(Channel inChannel)
 {
     sendControlChange(RPNLSB, 0x7f, inChannel);
     sendControlChange(RPNMSB, 0x7f, inChannel);
@@ -538,8 +632,8 @@ inline void MidiInterface<SerialPort, Settings>::endRpn(Channel inChannel)
  \param inNumber The 14-bit number of the NRPN you want to select.
  \param inChannel The channel on which the message will be sent (1 to 16).
 */
-template<class SerialPort, class Settings>
-inline void MidiInterface<SerialPort, Settings>::beginNrpn(unsigned inNumber,
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline void MidiInterface<SerialPort, Settings, Platform, Handler>::beginNrpn(unsigned inNumber,
                                                            Channel inChannel)
 {
     if (mCurrentNrpnNumber != inNumber)
@@ -556,8 +650,8 @@ inline void MidiInterface<SerialPort, Settings>::beginNrpn(unsigned inNumber,
  \param inValue  The 14-bit value of the selected NRPN.
  \param inChannel The channel on which the message will be sent (1 to 16).
 */
-template<class SerialPort, class Settings>
-inline void MidiInterface<SerialPort, Settings>::sendNrpnValue(unsigned inValue,
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline void MidiInterface<SerialPort, Settings, Platform, Handler>::sendNrpnValue(unsigned inValue,
                                                                Channel inChannel)
 {;
     const byte valMsb = 0x7f & (inValue >> 7);
@@ -571,8 +665,8 @@ inline void MidiInterface<SerialPort, Settings>::sendNrpnValue(unsigned inValue,
  \param inLsb The LSB part of the value to send. Meaning depends on NRPN number.
  \param inChannel The channel on which the message will be sent (1 to 16).
 */
-template<class SerialPort, class Settings>
-inline void MidiInterface<SerialPort, Settings>::sendNrpnValue(byte inMsb,
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline void MidiInterface<SerialPort, Settings, Platform, Handler>::sendNrpnValue(byte inMsb,
                                                                byte inLsb,
                                                                Channel inChannel)
 {
@@ -583,8 +677,8 @@ inline void MidiInterface<SerialPort, Settings>::sendNrpnValue(byte inMsb,
 /* \brief Increment the value of the currently selected NRPN number by the specified amount.
  \param inAmount The amount to add to the currently selected NRPN value.
 */
-template<class SerialPort, class Settings>
-inline void MidiInterface<SerialPort, Settings>::sendNrpnIncrement(byte inAmount,
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline void MidiInterface<SerialPort, Settings, Platform, Handler>::sendNrpnIncrement(byte inAmount,
                                                                    Channel inChannel)
 {
     sendControlChange(DataIncrement, inAmount, inChannel);
@@ -593,8 +687,8 @@ inline void MidiInterface<SerialPort, Settings>::sendNrpnIncrement(byte inAmount
 /* \brief Decrement the value of the currently selected NRPN number by the specified amount.
  \param inAmount The amount to subtract to the currently selected NRPN value.
 */
-template<class SerialPort, class Settings>
-inline void MidiInterface<SerialPort, Settings>::sendNrpnDecrement(byte inAmount,
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline void MidiInterface<SerialPort, Settings, Platform, Handler>::sendNrpnDecrement(byte inAmount,
                                                                    Channel inChannel)
 {
     sendControlChange(DataDecrement, inAmount, inChannel);
@@ -604,8 +698,8 @@ inline void MidiInterface<SerialPort, Settings>::sendNrpnDecrement(byte inAmount
 This will send a Null Function to deselect the currently selected NRPN.
  \param inChannel The channel on which the message will be sent (1 to 16).
 */
-template<class SerialPort, class Settings>
-inline void MidiInterface<SerialPort, Settings>::endNrpn(Channel inChannel)
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline void MidiInterface<SerialPort, Settings, Platform, Handler>::endNrpn(Channel inChannel)
 {
     sendControlChange(NRPNLSB, 0x7f, inChannel);
     sendControlChange(NRPNMSB, 0x7f, inChannel);
@@ -616,8 +710,8 @@ inline void MidiInterface<SerialPort, Settings>::endNrpn(Channel inChannel)
 
 // -----------------------------------------------------------------------------
 
-template<class SerialPort, class Settings>
-StatusByte MidiInterface<SerialPort, Settings>::getStatus(MidiType inType,
+template<class SerialPort, class Settings, class Platform, class Handler>
+StatusByte MidiInterface<SerialPort, Settings, Platform, Handler>::getStatus(MidiType inType,
                                                           Channel inChannel) const
 {
     return ((byte)inType | ((inChannel - 1) & 0x0f));
@@ -637,24 +731,314 @@ StatusByte MidiInterface<SerialPort, Settings>::getStatus(MidiType inType,
  A valid message is a message that matches the input channel. \n\n
  If the Thru is enabled and the message matches the filter,
  it is sent back on the MIDI output.
+
+ The work done by a call is bounded, whatever the bytes received
+ (checked by unit-tests_ParserBounds.cpp, measured by benchmarks_WorstCase.cpp):
+ - available() is called once on the port, and read() at most as many
+   times as available() returned, only once with Use1ByteParsing (unless
+   the message queue is enabled),
+ - each byte takes a single constant-time step of the parser, without
+   recursion nor going back over previous bytes,
+ - at most one message is handled (callbacks and Thru), plus one per Real
+   Time byte with UseRealTimeFastPath,
+ - Thru sends at most one message to each output: 3 bytes, or up to
+   SysExMaxSize for a SysEx. With UseCutThroughThru, at most 2 bytes per
+   byte read instead.
  @see see setInputChannel()
  */
-template<class SerialPort, class Settings>
-inline bool MidiInterface<SerialPort, Settings>::read()
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline bool MidiInterface<SerialPort, Settings, Platform, Handler>::read()
 {
     return read(mInputChannel);
 }
 
 /*! \brief Read messages on a specified channel.
  */
-template<class SerialPort, class Settings>
-inline bool MidiInterface<SerialPort, Settings>::read(Channel inChannel)
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline bool MidiInterface<SerialPort, Settings, Platform, Handler>::read(Channel inChannel)
 {
+    releaseHandledSysExBlock();
+
     if (inChannel >= MIDI_CHANNEL_OFF)
         return false; // MIDI Input disabled.
 
-    if (!parse())
-        return false;
+    const bool received = parse() && processMessage(inChannel);
+    flush(); // Thru
+    return received;
+}
+
+/*! \brief Parse a buffer of incoming bytes using the main input channel.
+
+ @see read(const byte*, unsigned, Channel)
+ */
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline unsigned MidiInterface<SerialPort, Settings, Platform, Handler>::read(const byte* inData,
+                                                          unsigned inSize)
+{
+    return read(inData, inSize, mInputChannel);
+}
+
+/*! \brief Parse a buffer of incoming bytes on a specified channel.
+
+ Use this when the bytes were obtained outside of the serial port (eg: a bulk
+ read on a file descriptor or a USB endpoint), to avoid paying for one
+ available() and one read() call per byte.
+ Every message completed by the buffer is handled the same way as with read():
+ callbacks are launched and Thru is applied, so the last one only is left in
+ the structure for getType() and friends. A message that straddles the end of
+ the buffer is kept pending and completed by the next call (or by read()).
+ \param inData    The bytes to parse.
+ \param inSize    The number of bytes in inData.
+ \param inChannel The channel to listen to.
+ \return The number of valid messages matching the input channel.
+ */
+template<class SerialPort, class Settings, class Platform, class Handler>
+unsigned MidiInterface<SerialPort, Settings, Platform, Handler>::read(const byte* inData,
+                                                   unsigned inSize,
+                                                   Channel inChannel)
+{
+    releaseHandledSysExBlock();
+
+    if (inChannel >= MIDI_CHANNEL_OFF)
+        return 0; // MIDI Input disabled.
+
+    unsigned count = 0;
+    if (mMessageHeld)
+    {
+        // Completed by readMessages(0), handled first.
+        mMessageHeld = false;
+        if (processMessage(inChannel))
+        {
+            count++;
+        }
+    }
+    for (unsigned i = 0; i < inSize; ++i)
+    {
+        if (!parseByte(inData[i]))
+        {
+            continue;
+        }
+        if (Settings::MessageQueueSize)
+        {
+            // Keep the order with messages queued by read(): the oldest
+            // one is handled first when there is no room for the new one.
+            if (mMessageQueue.isFull())
+            {
+                mMessageQueue.pop(mMessage);
+                if (processMessage(inChannel))
+                {
+                    count++;
+                }
+            }
+            pushMessage();
+            continue;
+        }
+        if (processMessage(inChannel))
+        {
+            count++;
+        }
+    }
+    while (mMessageQueue.pop(mMessage))
+    {
+        if (processMessage(inChannel))
+        {
+            count++;
+        }
+    }
+    flush(); // Thru
+    return count;
+}
+
+/*! \brief Read up to inMaxMessages messages using the main input channel.
+
+ @see readMessages(unsigned, Channel)
+ */
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline unsigned MidiInterface<SerialPort, Settings, Platform, Handler>::readMessages(unsigned inMaxMessages)
+{
+    return readMessages(inMaxMessages, mInputChannel);
+}
+
+/*! \brief Read up to inMaxMessages messages on a specified channel.
+
+ Empties a burst of incoming messages in a single call, instead of one
+ loop() iteration per message. Each message is handled as with read()
+ (callbacks and Thru). Bytes received while draining are left for the next
+ call, so the time spent here is bounded by what was already received.
+
+ With inMaxMessages set to 0, the bytes received are decoded without
+ handling any message, eg: to keep Real Time messages flowing with
+ Settings::UseRealTimeFastPath while the application holds the input.
+ Completed messages wait in the message queue. Without the queue, decoding
+ stops at the first completed message, which is handled by the next call.
+ \param inMaxMessages The maximum number of messages to handle.
+ \param inChannel     The channel to listen to.
+ \return The number of messages handled, whether or not they matched
+ the input channel.
+ @see readFor to bound the time spent instead.
+ */
+template<class SerialPort, class Settings, class Platform, class Handler>
+unsigned MidiInterface<SerialPort, Settings, Platform, Handler>::readMessages(unsigned inMaxMessages,
+                                                                     Channel inChannel)
+{
+    return drain<false>(inChannel, inMaxMessages, 0);
+}
+
+/*! \brief Read messages for a maximum duration using the main input channel.
+
+ @see readFor(unsigned long, Channel)
+ */
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline unsigned MidiInterface<SerialPort, Settings, Platform, Handler>::readFor(unsigned long inBudget)
+{
+    return readFor(inBudget, mInputChannel);
+}
+
+/*! \brief Read messages on a specified channel until a time budget is spent.
+
+ Same as readMessages, but stops when handling messages took longer than
+ inBudget, as measured with Platform::now(). The budget is checked after each
+ message, so the last one may overrun it by the duration of its callback.
+ \param inBudget  The time budget, in microseconds with the DefaultPlatform.
+ \param inChannel The channel to listen to.
+ \return The number of messages handled, whether or not they matched
+ the input channel.
+ */
+template<class SerialPort, class Settings, class Platform, class Handler>
+unsigned MidiInterface<SerialPort, Settings, Platform, Handler>::readFor(unsigned long inBudget,
+                                                                Channel inChannel)
+{
+    return drain<true>(inChannel, ~0u, inBudget);
+}
+
+/*! \brief Push a received byte into the parser.
+
+ Push-mode alternative to reading the serial port, meant to be called from a
+ UART receive interrupt or a DMA completion callback. Completed messages are
+ appended to the message queue (see DefaultSettings::MessageQueueSize) and
+ handed over by read() or readMessages() in the main loop, whose port should
+ then not deliver any byte itself.
+ Without the queue, a completed message is handled immediately (callbacks and
+ Thru), from the caller's context. Buffered Thru output is not flushed here,
+ see DefaultSettings::OutputBufferSize.
+ \param inData The received byte.
+ \return false when a completed message was dropped because the queue is full.
+ */
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline bool MidiInterface<SerialPort, Settings, Platform, Handler>::feed(byte inData)
+{
+    releaseHandledSysExBlock();
+
+    if (!parseByte(inData))
+    {
+        return true;
+    }
+
+    if (Settings::MessageQueueSize == 0)
+    {
+        if (mInputChannel < MIDI_CHANNEL_OFF)
+        {
+            processMessage(mInputChannel);
+        }
+        return true;
+    }
+
+    // When dropped, the workspace is reused by the next message.
+    return pushMessage();
+}
+
+/*! \brief Push a span of received bytes into the parser.
+
+ @see feed(byte)
+ \return false when at least one message was dropped because the queue is full.
+ */
+template<class SerialPort, class Settings, class Platform, class Handler>
+bool MidiInterface<SerialPort, Settings, Platform, Handler>::feed(const byte* inData,
+                                                         unsigned inSize)
+{
+    bool success = true;
+    for (unsigned i = 0; i < inSize; ++i)
+    {
+        success &= feed(inData[i]);
+    }
+    return success;
+}
+
+// Private method: handle the messages already received, within limits.
+// The clock is only used with a budget, so that readMessages works without one.
+template<class SerialPort, class Settings, class Platform, class Handler>
+template<bool UseBudget>
+unsigned MidiInterface<SerialPort, Settings, Platform, Handler>::drain(Channel inChannel,
+                                                              unsigned inMaxMessages,
+                                                              unsigned long inBudget)
+{
+    releaseHandledSysExBlock();
+
+    if (inChannel >= MIDI_CHANNEL_OFF)
+        return 0; // MIDI Input disabled.
+
+    const unsigned long start = UseBudget ? Platform::now() : 0;
+    unsigned count = 0;
+
+    if (Settings::MessageQueueSize)
+    {
+        enqueue();
+        while (count < inMaxMessages && mMessageQueue.pop(mMessage))
+        {
+            processMessage(inChannel);
+            count++;
+
+            if (UseBudget && (Platform::now() - start) >= inBudget)
+                break;
+        }
+        flush(); // Thru
+        return count;
+    }
+
+    int remaining = mSerial.available();
+
+    if (inMaxMessages == 0)
+    {
+        // Decode only, up to a message that has nowhere else to wait.
+        while (!mMessageHeld && remaining-- > 0)
+        {
+            mMessageHeld = parseByte(mSerial.read());
+        }
+        flush(); // Thru, Real Time fast path
+        return 0;
+    }
+
+    if (mMessageHeld)
+    {
+        mMessageHeld = false;
+        processMessage(inChannel);
+        count++;
+    }
+
+    while (count < inMaxMessages && remaining-- > 0)
+    {
+        if (parseByte(mSerial.read()))
+        {
+            processMessage(inChannel);
+            count++;
+
+            if (UseBudget && (Platform::now() - start) >= inBudget)
+                break;
+        }
+    }
+    flush(); // Thru
+    return count;
+}
+
+// Private method: handle a freshly parsed message (callbacks & Thru).
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline bool MidiInterface<SerialPort, Settings, Platform, Handler>::processMessage(Channel inChannel)
+{
+    MidiStatistics::countMessage(mMessage.type);
+    if (Settings::UseStatistics && Settings::UseReceiveTimestamps)
+    {
+        MidiStatistics::countLatency(Platform::now() - mMessage.getTimestamp());
+    }
 
     handleNullVelocityNoteOnAsNoteOff();
     const bool channelMatch = inputFilter(inChannel);
@@ -669,133 +1053,226 @@ inline bool MidiInterface<SerialPort, Settings>::read(Channel inChannel)
     return channelMatch;
 }
 
+// Private method: append the completed message to the queue.
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline bool MidiInterface<SerialPort, Settings, Platform, Handler>::pushMessage()
+{
+    if (mMessageQueue.push())
+    {
+        return true;
+    }
+    MidiStatistics::countQueueOverrun();
+    return false;
+}
+
 // -----------------------------------------------------------------------------
 
 // Private method: MIDI parser
-template<class SerialPort, class Settings>
-bool MidiInterface<SerialPort, Settings>::parse()
+template<class SerialPort, class Settings, class Platform, class Handler>
+bool MidiInterface<SerialPort, Settings, Platform, Handler>::parse()
 {
-    if (mSerial.available() == 0)
-        // No data available.
-        return false;
+    // Get bytes from the serial buffer and feed them to the parser,
+    // until a message is complete.
+    // Work is bounded: each byte costs one non-recursive call to parseByte,
+    // and no more than the bytes available upon entry are consumed, so a
+    // port that keeps receiving data cannot hold the caller forever.
+    // With Use1ByteParsing, a single byte is consumed per call.
+    // With the message queue, all the bytes received so far are decoded
+    // first, then the oldest message is taken out of the queue.
+    if (Settings::MessageQueueSize)
+    {
+        enqueue();
+        return mMessageQueue.pop(mMessage);
+    }
+
+    if (mMessageHeld)
+    {
+        // Completed by readMessages(0).
+        mMessageHeld = false;
+        return true;
+    }
+
+    int remaining = mSerial.available();
+
+    while (remaining-- > 0)
+    {
+        if (parseByte(mSerial.read()))
+            return true;
 
+        if (Settings::Use1ByteParsing)
+            break;
+    }
+
+    // No data available, or message is not complete.
+    return false;
+}
+
+// Private method: decode the bytes already received into the message queue.
+// Stops early when the queue is full, leaving bytes in the serial buffer.
+template<class SerialPort, class Settings, class Platform, class Handler>
+void MidiInterface<SerialPort, Settings, Platform, Handler>::enqueue()
+{
+    int remaining = mSerial.available();
+
+    while (remaining-- > 0 && !mMessageQueue.isFull())
+    {
+        if (parseByte(mSerial.read()))
+        {
+            pushMessage();
+        }
+    }
+}
+
+// Private method: push one byte into the parser state machine.
+// Returns true when the byte completes a message, stored in the workspace
+// of the message queue (mMessage when the queue is disabled).
+template<class SerialPort, class Settings, class Platform, class Handler>
+bool MidiInterface<SerialPort, Settings, Platform, Handler>::parseByte(byte inData)
+{
     // Parsing algorithm:
-    // Get a byte from the serial buffer.
     // If there is no pending message to be recomposed, start a new one.
-    //  - Find type and channel (if pertinent)
-    //  - Look for other bytes in buffer, call parser recursively,
-    //    until the message is assembled or the buffer is empty.
-    // Else, add the extracted byte to the pending message, and check validity.
+    //  - Find type, length and channel (if pertinent) from the status table
+    //  - Wait for the other bytes of the message to come in.
+    // Else, add the byte to the pending message, and check validity.
     // When the message is done, store it.
 
-    const byte extracted = mSerial.read();
+    MidiMessage& message = mMessageQueue.getWorkspace(mMessage);
+    MidiStatistics::countByte();
 
-    // Ignore Undefined
-    if (extracted == 0xf9 || extracted == 0xfd)
+    if (Settings::UseRealTimeFastPath && inData >= 0xf8)
     {
-        if (Settings::Use1ByteParsing)
+        // Handled right away, without touching the pending message.
+        handleRealTime(inData);
+        return false;
+    }
+
+    // Ignore Undefined (0xf9 & 0xfd)
+    if (inData >= 0xf8 && !StatusTable::isDefined(inData))
+    {
+        MidiStatistics::countInvalidStatusByte();
+        return false;
+    }
+
+    if (mPendingMessageIndex == 0)
+    {
+        if (inData >= 0x80)
         {
-            return false;
+            // A new message starts, the previous SysEx frame has been handled.
+            releaseSysExBlock();
         }
-        else
+        if (Settings::UseReceiveTimestamps)
         {
-            return parse();
+            mPendingTime.setTimestamp(Platform::now());
         }
-    }
 
-    if (mPendingMessageIndex == 0)
-    {
         // Start a new pending message
-        mPendingMessage[0] = extracted;
+        mPendingMessage[0] = inData;
+
+        // Check for running status first:
+        // only channel messages are stored in mRunningStatus_RX.
+        // If the status byte is not received, prepend it to the pending message.
+        // Else, well, we received another status byte, so the running status
+        // does not apply here. It will be updated upon completion of this message.
+        if (inData < 0x80 && mRunningStatus_RX != InvalidType)
+        {
+            mPendingMessage[0]   = mRunningStatus_RX;
+            mPendingMessage[1]   = inData;
+            mPendingMessageIndex = 1;
+        }
+
+        const byte flags  = StatusTable::getFlags(mPendingMessage[0]);
+        const byte length = flags & StatusTable::LengthMask;
 
-        // Check for running status first
-        if (isChannelMessage(getTypeFromStatusByte(mRunningStatus_RX)))
+        if (!(flags & StatusTable::Defined))
         {
-            // Only these types allow Running Status
+            // This is obviously wrong. Let's get the hell out'a here.
+            if (inData >= 0x80)
+                MidiStatistics::countInvalidStatusByte();
+            else
+                MidiStatistics::countStrayDataByte();
+            resetInput();
+            return false;
+        }
 
-            // If the status byte is not received, prepend it
-            // to the pending message
-            if (extracted < 0x80)
+        if (Settings::UseCutThroughThru)
+        {
+            if (flags & StatusTable::RealTime)
             {
-                mPendingMessage[0]   = mRunningStatus_RX;
-                mPendingMessage[1]   = extracted;
-                mPendingMessageIndex = 1;
+                thruRealTime(inData);
+            }
+            else if (inData >= 0x80)
+            {
+                thruStatus(inData);
+            }
+            else
+            {
+                if (mThruForwarding && mRunningStatus_TX != mPendingMessage[0])
+                {
+                    // Something else was sent in between, restore the status.
+                    thruStatus(mPendingMessage[0]);
+                }
+                thruData(inData);
             }
-            // Else: well, we received another status byte,
-            // so the running status does not apply here.
-            // It will be updated upon completion of this message.
         }
 
-        switch (getTypeFromStatusByte(mPendingMessage[0]))
+        if (length == 1)
         {
-            // 1 byte messages
-            case Start:
-            case Continue:
-            case Stop:
-            case Clock:
-            case ActiveSensing:
-            case SystemReset:
-            case TuneRequest:
-                // Handle the message type directly here.
-                mMessage.type    = getTypeFromStatusByte(mPendingMessage[0]);
-                mMessage.channel = 0;
-                mMessage.data1   = 0;
-                mMessage.data2   = 0;
-                mMessage.valid   = true;
-
-                // Do not reset all input attributes, Running Status must remain unchanged.
-                // We still need to reset these
-                mPendingMessageIndex = 0;
-                mPendingMessageExpectedLenght = 0;
-
-                return true;
-                break;
-
-                // 2 bytes messages
-            case ProgramChange:
-            case AfterTouchChannel:
-            case TimeCodeQuarterFrame:
-            case SongSelect:
-                mPendingMessageExpectedLenght = 2;
-                break;
-
-                // 3 bytes messages
-            case NoteOn:
-            case NoteOff:
-            case ControlChange:
-            case PitchBend:
-            case AfterTouchPoly:
-            case SongPosition:
-                mPendingMessageExpectedLenght = 3;
-                break;
-
-            case SystemExclusive:
-                // The message can be any lenght
-                // between 3 and MidiMessage::sSysExMaxSize bytes
-                mPendingMessageExpectedLenght = MidiMessage::sSysExMaxSize;
-                mRunningStatus_RX = InvalidType;
-                mMessage.sysexArray[0] = SystemExclusive;
-                break;
+            // Real Time and Tune Request: handle the message type directly here.
+            message.type    = StatusTable::getType(mPendingMessage[0]);
+            message.channel = 0;
+            message.data1   = 0;
+            message.data2   = 0;
+            message.valid   = true;
+            message.setTimestamp(mPendingTime.getTimestamp());
+
+            // Do not reset all input attributes, Running Status must remain unchanged.
+            // We still need to reset these
+            mPendingMessageIndex = 0;
+            mPendingMessageExpectedLenght = 0;
 
-            case InvalidType:
-            default:
-                // This is obviously wrong. Let's get the hell out'a here.
-                resetInput();
-                return false;
-                break;
+            return true;
+        }
+        else if (length == 0)
+        {
+            // SystemExclusive: the message can be any lenght
+            // between 3 and MidiMessage::sSysExMaxSize bytes
+            mPendingMessageExpectedLenght = MidiMessage::sSysExMaxSize;
+            mRunningStatus_RX = InvalidType;
+            if (Settings::MessageQueueSize == 0 && mSysExPool != 0 &&
+                !Handler::usesSysExChunks())
+            {
+                // Falls back on the message buffer when the pool is exhausted.
+                mSysExBlock = mSysExPool->acquire();
+                if (mSysExBlock != 0)
+                {
+                    mSysExBlockPool = mSysExPool;
+                    mPendingMessageExpectedLenght = mSysExPool->getBlockSize();
+                }
+            }
+            message.sysexArray[0] = SystemExclusive;
+            if (mSysExBlock != 0)
+            {
+                mSysExBlock[0] = SystemExclusive;
+            }
+            mSysExChunkLength = 1;
+        }
+        else
+        {
+            mPendingMessageExpectedLenght = length;
         }
 
         if (mPendingMessageIndex >= (mPendingMessageExpectedLenght - 1))
         {
             // Reception complete
-            mMessage.type    = getTypeFromStatusByte(mPendingMessage[0]);
-            mMessage.channel = getChannelFromStatusByte(mPendingMessage[0]);
-            mMessage.data1   = mPendingMessage[1];
-            mMessage.data2   = 0; // Completed new message has 1 data byte
+            message.type    = StatusTable::getType(mPendingMessage[0]);
+            message.channel = getChannelFromStatusByte(mPendingMessage[0]);
+            message.data1   = mPendingMessage[1];
+            message.data2   = 0; // Completed new message has 1 data byte
+            message.setTimestamp(mPendingTime.getTimestamp());
 
             mPendingMessageIndex = 0;
             mPendingMessageExpectedLenght = 0;
-            mMessage.valid = true;
+            message.valid = true;
             return true;
         }
         else
@@ -804,82 +1281,113 @@ bool MidiInterface<SerialPort, Settings>::parse()
             mPendingMessageIndex++;
         }
 
-        if (Settings::Use1ByteParsing)
-        {
-            // Message is not complete.
-            return false;
-        }
-        else
-        {
-            // Call the parser recursively
-            // to parse the rest of the message.
-            return parse();
-        }
+        // Message is not complete.
+        return false;
     }
     else
     {
         // First, test if this is a status byte
-        if (extracted >= 0x80)
+        if (inData >= 0x80)
         {
             // Reception of status bytes in the middle of an uncompleted message
             // are allowed only for interleaved Real Time message or EOX
-            switch (extracted)
+            if (StatusTable::isRealTime(inData))
             {
-                case Clock:
-                case Start:
-                case Continue:
-                case Stop:
-                case ActiveSensing:
-                case SystemReset:
-
-                    // Here we will have to extract the one-byte message,
-                    // pass it to the structure for being read outside
-                    // the MIDI class, and recompose the message it was
-                    // interleaved into. Oh, and without killing the running status..
-                    // This is done by leaving the pending message as is,
-                    // it will be completed on next calls.
-
-                    mMessage.type    = (MidiType)extracted;
-                    mMessage.data1   = 0;
-                    mMessage.data2   = 0;
-                    mMessage.channel = 0;
-                    mMessage.valid   = true;
-                    return true;
+                // Here we will have to extract the one-byte message,
+                // pass it to the structure for being read outside
+                // the MIDI class, and recompose the message it was
+                // interleaved into. Oh, and without killing the running status..
+                // This is done by leaving the pending message as is,
+                // it will be completed on next calls.
+
+                if (Settings::UseCutThroughThru)
+                {
+                    thruRealTime(inData);
+                }
 
-                    // End of Exclusive
-                case 0xf7:
-                    if (mMessage.sysexArray[0] == SystemExclusive)
+                message.type    = (MidiType)inData;
+                message.data1   = 0;
+                message.data2   = 0;
+                message.channel = 0;
+                message.valid   = true;
+                if (Settings::UseReceiveTimestamps)
+                {
+                    message.setTimestamp(Platform::now());
+                }
+                return true;
+            }
+            else if (inData == 0xf7)
+            {
+                // End of Exclusive
+                if (mPendingMessage[0] == SystemExclusive)
+                {
+                    if (Settings::UseCutThroughThru)
                     {
-                        // Store the last byte (EOX)
-                        mMessage.sysexArray[mPendingMessageIndex++] = 0xf7;
-                        mMessage.type = SystemExclusive;
-
-                        // Get length
-                        mMessage.data1   = mPendingMessageIndex & 0xff; // LSB
-                        mMessage.data2   = mPendingMessageIndex >> 8;   // MSB
-                        mMessage.channel = 0;
-                        mMessage.valid   = true;
-
-                        resetInput();
-                        return true;
+                        thruData(0xf7);
+                    }
+                    if (Handler::usesSysExChunks())
+                    {
+                        // Streaming: the last chunk is the end of the message.
+                        message.sysexArray[mSysExChunkLength++] = 0xf7;
+                        mPendingMessageIndex = mSysExChunkLength;
                     }
                     else
                     {
-                        // Well well well.. error.
-                        resetInput();
-                        return false;
+                        // Store the last byte (EOX)
+                        byte* sysex = mSysExBlock != 0 ? mSysExBlock : message.sysexArray;
+                        sysex[mPendingMessageIndex++] = 0xf7;
                     }
+                    message.type = SystemExclusive;
 
-                default:
-                    break; // LCOV_EXCL_LINE - Coverage blind spot
+                    // Get length
+                    message.data1   = mPendingMessageIndex & 0xff; // LSB
+                    message.data2   = mPendingMessageIndex >> 8;   // MSB
+                    message.channel = 0;
+                    message.valid   = true;
+                    message.setTimestamp(mPendingTime.getTimestamp());
+
+                    resetInput();
+                    return true;
+                }
+                else
+                {
+                    // Well well well.. error.
+                    MidiStatistics::countInvalidStatusByte();
+                    resetInput();
+                    return false;
+                }
             }
         }
 
+        if (Settings::UseCutThroughThru)
+        {
+            thruData(inData);
+        }
+
         // Add extracted data byte to pending message
-        if (mPendingMessage[0] == SystemExclusive)
-            mMessage.sysexArray[mPendingMessageIndex] = extracted;
+        if (mPendingMessage[0] == SystemExclusive && Handler::usesSysExChunks())
+        {
+            // Streaming: hand over the chunk as soon as the buffer is full,
+            // the pending index only tells a message is in progress.
+            message.sysexArray[mSysExChunkLength++] = inData;
+            if (mSysExChunkLength < MidiMessage::sSysExMaxSize)
+            {
+                return false;
+            }
+
+            message.type    = SystemExclusive;
+            message.data1   = mSysExChunkLength & 0xff; // LSB
+            message.data2   = mSysExChunkLength >> 8;   // MSB
+            message.channel = 0;
+            message.valid   = true;
+            message.setTimestamp(mPendingTime.getTimestamp());
+            mSysExChunkLength = 0;
+            return true;
+        }
+        else if (mPendingMessage[0] == SystemExclusive)
+            (mSysExBlock != 0 ? mSysExBlock : message.sysexArray)[mPendingMessageIndex] = inData;
         else
-            mPendingMessage[mPendingMessageIndex] = extracted;
+            mPendingMessage[mPendingMessageIndex] = inData;
 
         // Now we are going to check if we have reached the end of the message
         if (mPendingMessageIndex >= (mPendingMessageExpectedLenght - 1))
@@ -889,46 +1397,48 @@ bool MidiInterface<SerialPort, Settings>::parse()
             // the buffer. If this happens, try increasing MidiMessage::sSysExMaxSize.
             if (mPendingMessage[0] == SystemExclusive)
             {
+                if (Settings::UseCutThroughThru)
+                {
+                    // Close the message on the output.
+                    thruData(0xf7);
+                    mThruForwarding = false;
+                }
+                MidiStatistics::countSysExOverflow();
                 resetInput();
                 return false;
             }
 
-            mMessage.type = getTypeFromStatusByte(mPendingMessage[0]);
+            const byte flags = StatusTable::getFlags(mPendingMessage[0]);
+
+            message.type = StatusTable::getType(mPendingMessage[0]);
 
-            if (isChannelMessage(mMessage.type))
-                mMessage.channel = getChannelFromStatusByte(mPendingMessage[0]);
+            if (flags & StatusTable::ChannelMessage)
+                message.channel = getChannelFromStatusByte(mPendingMessage[0]);
             else
-                mMessage.channel = 0;
+                message.channel = 0;
 
-            mMessage.data1 = mPendingMessage[1];
+            message.data1 = mPendingMessage[1];
 
             // Save data2 only if applicable
-            mMessage.data2 = mPendingMessageExpectedLenght == 3 ? mPendingMessage[2] : 0;
+            message.data2 = mPendingMessageExpectedLenght == 3 ? mPendingMessage[2] : 0;
+            message.setTimestamp(mPendingTime.getTimestamp());
 
             // Reset local variables
             mPendingMessageIndex = 0;
             mPendingMessageExpectedLenght = 0;
 
-            mMessage.valid = true;
+            message.valid = true;
 
             // Activate running status (if enabled for the received type)
-            switch (mMessage.type)
+            if (flags & StatusTable::ChannelMessage)
             {
-                case NoteOff:
-                case NoteOn:
-                case AfterTouchPoly:
-                case ControlChange:
-                case ProgramChange:
-                case AfterTouchChannel:
-                case PitchBend:
-                    // Running status enabled: store it from received message
-                    mRunningStatus_RX = mPendingMessage[0];
-                    break;
-
-                default:
-                    // No running status
-                    mRunningStatus_RX = InvalidType;
-                    break;
+                // Running status enabled: store it from received message
+                mRunningStatus_RX = mPendingMessage[0];
+            }
+            else
+            {
+                // No running status
+                mRunningStatus_RX = InvalidType;
             }
             return true;
         }
@@ -937,23 +1447,45 @@ bool MidiInterface<SerialPort, Settings>::parse()
             // Then update the index of the pending message.
             mPendingMessageIndex++;
 
-            if (Settings::Use1ByteParsing)
-            {
-                // Message is not complete.
-                return false;
-            }
-            else
-            {
-                // Call the parser recursively to parse the rest of the message.
-                return parse();
-            }
+            // Message is not complete.
+            return false;
         }
     }
 }
 
 // Private method, see midi_Settings.h for documentation
-template<class SerialPort, class Settings>
-inline void MidiInterface<SerialPort, Settings>::handleNullVelocityNoteOnAsNoteOff()
+template<class SerialPort, class Settings, class Platform, class Handler>
+void MidiInterface<SerialPort, Settings, Platform, Handler>::handleRealTime(byte inData)
+{
+    if (mInputChannel >= MIDI_CHANNEL_OFF)
+    {
+        return; // MIDI Input disabled, as for the other messages.
+    }
+
+    switch (inData)
+    {
+        case Clock:         Handler::handleClock(); break;
+        case Start:         Handler::handleStart(); break;
+        case Continue:      Handler::handleContinue(); break;
+        case Stop:          Handler::handleStop(); break;
+        case ActiveSensing: Handler::handleActiveSensing(); break;
+        case SystemReset:   Handler::handleSystemReset(); break;
+        default:
+            MidiStatistics::countInvalidStatusByte();
+            return; // Undefined (0xf9 & 0xfd)
+    }
+    MidiStatistics::countMessage(MidiType(inData));
+
+    if (mThruActivated && mThruFilterMode != Thru::Off)
+    {
+        sendRealTime(MidiType(inData));
+    }
+    thruToOutputs(&inData, 1, inData, mInputChannel);
+}
+
+// Private method, see midi_Settings.h for documentation
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline void MidiInterface<SerialPort, Settings, Platform, Handler>::handleNullVelocityNoteOnAsNoteOff()
 {
     if (Settings::HandleNullVelocityNoteOnAsNoteOff &&
         getType() == NoteOn && getData2() == 0)
@@ -963,14 +1495,14 @@ inline void MidiInterface<SerialPort, Settings>::handleNullVelocityNoteOnAsNoteO
 }
 
 // Private method: check if the received message is on the listened channel
-template<class SerialPort, class Settings>
-inline bool MidiInterface<SerialPort, Settings>::inputFilter(Channel inChannel)
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline bool MidiInterface<SerialPort, Settings, Platform, Handler>::inputFilter(Channel inChannel)
 {
     // This method handles recognition of channel
     // (to know if the message is destinated to the Arduino)
 
     // First, check if the received message is Channel
-    if (mMessage.type >= NoteOff && mMessage.type <= PitchBend)
+    if (StatusTable::isChannelMessage(mMessage.type))
     {
         // Then we need to know if we listen to it
         if ((mMessage.channel == inChannel) ||
@@ -992,22 +1524,52 @@ inline bool MidiInterface<SerialPort, Settings>::inputFilter(Channel inChannel)
 }
 
 // Private method: reset input attributes
-template<class SerialPort, class Settings>
-inline void MidiInterface<SerialPort, Settings>::resetInput()
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline void MidiInterface<SerialPort, Settings, Platform, Handler>::resetInput()
 {
     mPendingMessageIndex = 0;
     mPendingMessageExpectedLenght = 0;
     mRunningStatus_RX = InvalidType;
 }
 
+// Private method: SysEx payload of mMessage, in the pool block if it has one.
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline byte* MidiInterface<SerialPort, Settings, Platform, Handler>::getSysExPayload()
+{
+    return mSysExBlock != 0 ? mSysExBlock : mMessage.sysexArray;
+}
+
+// Private method: give the SysEx block of the last message back to the pool,
+// once the application is done with it, ie: when reading the input again.
+// A frame being received, or waiting to be handled, keeps its block.
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline void MidiInterface<SerialPort, Settings, Platform, Handler>::releaseHandledSysExBlock()
+{
+    if (mPendingMessageIndex == 0 && !mMessageHeld)
+    {
+        releaseSysExBlock();
+    }
+}
+
+// Private method: give the SysEx block back to the pool it was borrowed from.
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline void MidiInterface<SerialPort, Settings, Platform, Handler>::releaseSysExBlock()
+{
+    if (mSysExBlock != 0)
+    {
+        mSysExBlockPool->release(mSysExBlock);
+        mSysExBlock = 0;
+    }
+}
+
 // -----------------------------------------------------------------------------
 
 /*! \brief Get the last received message's type
 
  Returns an enumerated type. @see MidiType
  */
-template<class SerialPort, class Settings>
-inline MidiType MidiInterface<SerialPort, Settings>::getType() const
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline MidiType MidiInterface<SerialPort, Settings, Platform, Handler>::getType() const
 {
     return mMessage.type;
 }
@@ -1017,22 +1579,22 @@ inline MidiType MidiInterface<SerialPort, Settings>::getType() const
  \return Channel range is 1 to 16.
  For non-channel messages, this will return 0.
  */
-template<class SerialPort, class Settings>
-inline Channel MidiInterface<SerialPort, Settings>::getChannel() const
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline Channel MidiInterface<SerialPort, Settings, Platform, Handler>::getChannel() const
 {
     return mMessage.channel;
 }
 
 /*! \brief Get the first data byte of the last received message. */
-template<class SerialPort, class Settings>
-inline DataByte MidiInterface<SerialPort, Settings>::getData1() const
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline DataByte MidiInterface<SerialPort, Settings, Platform, Handler>::getData1() const
 {
     return mMessage.data1;
 }
 
 /*! \brief Get the second data byte of the last received message. */
-template<class SerialPort, class Settings>
-inline DataByte MidiInterface<SerialPort, Settings>::getData2() const
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline DataByte MidiInterface<SerialPort, Settings, Platform, Handler>::getData2() const
 {
     return mMessage.data2;
 }
@@ -1041,10 +1603,10 @@ inline DataByte MidiInterface<SerialPort, Settings>::getData2() const
 
  @see getSysExArrayLength to get the array's length in bytes.
  */
-template<class SerialPort, class Settings>
-inline const byte* MidiInterface<SerialPort, Settings>::getSysExArray() const
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline const byte* MidiInterface<SerialPort, Settings, Platform, Handler>::getSysExArray() const
 {
-    return mMessage.sysexArray;
+    return mSysExBlock != 0 ? mSysExBlock : mMessage.sysexArray;
 }
 
 /*! \brief Get the lenght of the System Exclusive array.
@@ -1052,23 +1614,64 @@ inline const byte* MidiInterface<SerialPort, Settings>::getSysExArray() const
  It is coded using data1 as LSB and data2 as MSB.
  \return The array's length, in bytes.
  */
-template<class SerialPort, class Settings>
-inline unsigned MidiInterface<SerialPort, Settings>::getSysExArrayLength() const
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline unsigned MidiInterface<SerialPort, Settings, Platform, Handler>::getSysExArrayLength() const
 {
+    if (mSysExBlock != 0)
+    {
+        // Pool blocks can be larger than the message buffer.
+        return unsigned(mMessage.data2) << 8 | mMessage.data1;
+    }
     return mMessage.getSysExSize();
 }
 
+/*! \brief Get the time when the first byte of the last message was parsed.
+
+ In Platform::now() units. Always 0 unless Settings::UseReceiveTimestamps is
+ enabled.
+ */
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline unsigned long MidiInterface<SerialPort, Settings, Platform, Handler>::getTimestamp() const
+{
+    return mMessage.getTimestamp();
+}
+
 /*! \brief Check if a valid message is stored in the structure. */
-template<class SerialPort, class Settings>
-inline bool MidiInterface<SerialPort, Settings>::check() const
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline bool MidiInterface<SerialPort, Settings, Platform, Handler>::check() const
 {
     return mMessage.valid;
 }
 
+/*! \brief Receive SysEx frames in blocks borrowed from a shared pool.
+
+ The block is held from the start of a frame until the next call to read(),
+ readMessages(), readFor() or feed() on this instance, so getSysExArray
+ remains valid after read() returns, and a port that goes quiet after a frame
+ does not keep its block.
+ When the pool is exhausted, the frame is received in the instance's own
+ buffer (see SysExPool for the drop policy).
+ Pools are not used with the message queue or the SysEx chunk callback.
+ Changing the pool drops a frame being received in a block, while the last
+ message keeps its block until the input is read again, as above.
+ \param inPool The pool to use, or 0 to only use the instance's buffer.
+ */
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline void MidiInterface<SerialPort, Settings, Platform, Handler>::setSysExPool(SysExPool* inPool)
+{
+    if (mSysExBlock != 0 && mPendingMessageIndex != 0)
+    {
+        // Drop the frame being received in the block.
+        resetInput();
+        releaseSysExBlock();
+    }
+    mSysExPool = inPool;
+}
+
 // -----------------------------------------------------------------------------
 
-template<class SerialPort, class Settings>
-inline Channel MidiInterface<SerialPort, Settings>::getInputChannel() const
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline Channel MidiInterface<SerialPort, Settings, Platform, Handler>::getInputChannel() const
 {
     return mInputChannel;
 }
@@ -1077,58 +1680,58 @@ inline Channel MidiInterface<SerialPort, Settings>::getInputChannel() const
  \param inChannel the channel value. Valid values are 1 to 16, MIDI_CHANNEL_OMNI
  if you want to listen to all channels, and MIDI_CHANNEL_OFF to disable input.
  */
-template<class SerialPort, class Settings>
-inline void MidiInterface<SerialPort, Settings>::setInputChannel(Channel inChannel)
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline void MidiInterface<SerialPort, Settings, Platform, Handler>::setInputChannel(Channel inChannel)
 {
     mInputChannel = inChannel;
 }
 
 // -----------------------------------------------------------------------------
 
+/*! \brief Get a copy of the input counters.
+
+ Always zero unless Settings::UseStatistics is enabled.
+ @see midi_Statistics.h
+ */
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline typename MidiInterface<SerialPort, Settings, Platform, Handler>::MidiStatistics
+MidiInterface<SerialPort, Settings, Platform, Handler>::getStatistics() const
+{
+    return *this;
+}
+
+/*! \brief Clear the input counters, they are also cleared by begin(). */
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline void MidiInterface<SerialPort, Settings, Platform, Handler>::resetStatistics()
+{
+    MidiStatistics::reset();
+}
+
+// -----------------------------------------------------------------------------
+
 /*! \brief Extract an enumerated MIDI type from a status byte.
 
  This is a utility static method, used internally,
  made public so you can handle MidiTypes more easily.
  */
-template<class SerialPort, class Settings>
-MidiType MidiInterface<SerialPort, Settings>::getTypeFromStatusByte(byte inStatus)
-{
-    if ((inStatus  < 0x80) ||
-        (inStatus == 0xf4) ||
-        (inStatus == 0xf5) ||
-        (inStatus == 0xf9) ||
-        (inStatus == 0xfD))
-    {
-        // Data bytes and undefined.
-        return InvalidType;
-    }
-    if (inStatus < 0xf0)
-    {
-        // Channel message, remove channel nibble.
-        return MidiType(inStatus & 0xf0);
-    }
-
-    return MidiType(inStatus);
+template<class SerialPort, class Settings, class Platform, class Handler>
+MidiType MidiInterface<SerialPort, Settings, Platform, Handler>::getTypeFromStatusByte(byte inStatus)
+{
+    return StatusTable::getType(inStatus);
 }
 
 /*! \brief Returns channel in the range 1-16
  */
-template<class SerialPort, class Settings>
-inline Channel MidiInterface<SerialPort, Settings>::getChannelFromStatusByte(byte inStatus)
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline Channel MidiInterface<SerialPort, Settings, Platform, Handler>::getChannelFromStatusByte(byte inStatus)
 {
     return (inStatus & 0x0f) + 1;
 }
 
-template<class SerialPort, class Settings>
-bool MidiInterface<SerialPort, Settings>::isChannelMessage(MidiType inType)
+template<class SerialPort, class Settings, class Platform, class Handler>
+bool MidiInterface<SerialPort, Settings, Platform, Handler>::isChannelMessage(MidiType inType)
 {
-    return (inType == NoteOff           ||
-            inType == NoteOn            ||
-            inType == ControlChange     ||
-            inType == AfterTouchPoly    ||
-            inType == AfterTouchChannel ||
-            inType == PitchBend         ||
-            inType == ProgramChange);
+    return StatusTable::isChannelMessage(inType);
 }
 
 // -----------------------------------------------------------------------------
@@ -1137,24 +1740,33 @@ bool MidiInterface<SerialPort, Settings>::isChannelMessage(MidiType inType)
  @{
  */
 
-template<class SerialPort, class Settings> void MidiInterface<SerialPort, Settings>::setHandleNoteOff(void (*fptr)(byte channel, byte note, byte velocity))          { mNoteOffCallback              = fptr; }
-template<class SerialPort, class Settings> void MidiInterface<SerialPort, Settings>::setHandleNoteOn(void (*fptr)(byte channel, byte note, byte velocity))           { mNoteOnCallback               = fptr; }
-template<class SerialPort, class Settings> void MidiInterface<SerialPort, Settings>::setHandleAfterTouchPoly(void (*fptr)(byte channel, byte note, byte pressure))   { mAfterTouchPolyCallback       = fptr; }
-template<class SerialPort, class Settings> void MidiInterface<SerialPort, Settings>::setHandleControlChange(void (*fptr)(byte channel, byte number, byte value))     { mControlChangeCallback        = fptr; }
-template<class SerialPort, class Settings> void MidiInterface<SerialPort, Settings>::setHandleProgramChange(void (*fptr)(byte channel, byte number))                 { mProgramChangeCallback        = fptr; }
-template<class SerialPort, class Settings> void MidiInterface<SerialPort, Settings>::setHandleAfterTouchChannel(void (*fptr)(byte channel, byte pressure))           { mAfterTouchChannelCallback    = fptr; }
-template<class SerialPort, class Settings> void MidiInterface<SerialPort, Settings>::setHandlePitchBend(void (*fptr)(byte channel, int bend))                        { mPitchBendCallback            = fptr; }
-template<class SerialPort, class Settings> void MidiInterface<SerialPort, Settings>::setHandleSystemExclusive(void (*fptr)(byte* array, unsigned size))              { mSystemExclusiveCallback      = fptr; }
-template<class SerialPort, class Settings> void MidiInterface<SerialPort, Settings>::setHandleTimeCodeQuarterFrame(void (*fptr)(byte data))                          { mTimeCodeQuarterFrameCallback = fptr; }
-template<class SerialPort, class Settings> void MidiInterface<SerialPort, Settings>::setHandleSongPosition(void (*fptr)(unsigned beats))                             { mSongPositionCallback         = fptr; }
-template<class SerialPort, class Settings> void MidiInterface<SerialPort, Settings>::setHandleSongSelect(void (*fptr)(byte songnumber))                              { mSongSelectCallback           = fptr; }
-template<class SerialPort, class Settings> void MidiInterface<SerialPort, Settings>::setHandleTuneRequest(void (*fptr)(void))                                        { mTuneRequestCallback          = fptr; }
-template<class SerialPort, class Settings> void MidiInterface<SerialPort, Settings>::setHandleClock(void (*fptr)(void))                                              { mClockCallback                = fptr; }
-template<class SerialPort, class Settings> void MidiInterface<SerialPort, Settings>::setHandleStart(void (*fptr)(void))                                              { mStartCallback                = fptr; }
-template<class SerialPort, class Settings> void MidiInterface<SerialPort, Settings>::setHandleContinue(void (*fptr)(void))                                           { mContinueCallback             = fptr; }
-template<class SerialPort, class Settings> void MidiInterface<SerialPort, Settings>::setHandleStop(void (*fptr)(void))                                               { mStopCallback                 = fptr; }
-template<class SerialPort, class Settings> void MidiInterface<SerialPort, Settings>::setHandleActiveSensing(void (*fptr)(void))                                      { mActiveSensingCallback        = fptr; }
-template<class SerialPort, class Settings> void MidiInterface<SerialPort, Settings>::setHandleSystemReset(void (*fptr)(void))                                        { mSystemResetCallback          = fptr; }
+/*! Callbacks accept plain functions or Delegates bound to an object method.
+ The message callback (setHandleMessage) is called for every message before
+ the callback of its type. Real Time messages handled by the fast path
+ (Settings::UseRealTimeFastPath) only reach their own callbacks, and SysEx
+ received in a pool block is read with getSysExArray.
+ */
+
+template<class SerialPort, class Settings, class Platform, class Handler> void MidiInterface<SerialPort, Settings, Platform, Handler>::setHandleMessage(Delegate<void(const MidiMessage& message)> inCallback)                       { Handler::mMessageCallback              = inCallback; }
+template<class SerialPort, class Settings, class Platform, class Handler> void MidiInterface<SerialPort, Settings, Platform, Handler>::setHandleNoteOff(Delegate<void(byte channel, byte note, byte velocity)> inCallback)           { Handler::mNoteOffCallback              = inCallback; }
+template<class SerialPort, class Settings, class Platform, class Handler> void MidiInterface<SerialPort, Settings, Platform, Handler>::setHandleNoteOn(Delegate<void(byte channel, byte note, byte velocity)> inCallback)            { Handler::mNoteOnCallback               = inCallback; }
+template<class SerialPort, class Settings, class Platform, class Handler> void MidiInterface<SerialPort, Settings, Platform, Handler>::setHandleAfterTouchPoly(Delegate<void(byte channel, byte note, byte pressure)> inCallback)    { Handler::mAfterTouchPolyCallback       = inCallback; }
+template<class SerialPort, class Settings, class Platform, class Handler> void MidiInterface<SerialPort, Settings, Platform, Handler>::setHandleControlChange(Delegate<void(byte channel, byte number, byte value)> inCallback)      { Handler::mControlChangeCallback        = inCallback; }
+template<class SerialPort, class Settings, class Platform, class Handler> void MidiInterface<SerialPort, Settings, Platform, Handler>::setHandleProgramChange(Delegate<void(byte channel, byte number)> inCallback)                  { Handler::mProgramChangeCallback        = inCallback; }
+template<class SerialPort, class Settings, class Platform, class Handler> void MidiInterface<SerialPort, Settings, Platform, Handler>::setHandleAfterTouchChannel(Delegate<void(byte channel, byte pressure)> inCallback)            { Handler::mAfterTouchChannelCallback    = inCallback; }
+template<class SerialPort, class Settings, class Platform, class Handler> void MidiInterface<SerialPort, Settings, Platform, Handler>::setHandlePitchBend(Delegate<void(byte channel, int bend)> inCallback)                         { Handler::mPitchBendCallback            = inCallback; }
+template<class SerialPort, class Settings, class Platform, class Handler> void MidiInterface<SerialPort, Settings, Platform, Handler>::setHandleSystemExclusive(Delegate<void(byte* array, unsigned size)> inCallback)               { Handler::mSystemExclusiveCallback      = inCallback; }
+template<class SerialPort, class Settings, class Platform, class Handler> void MidiInterface<SerialPort, Settings, Platform, Handler>::setHandleSystemExclusiveChunk(Delegate<void(byte* array, unsigned size, byte flags)> inCallback) { Handler::mSystemExclusiveChunkCallback = inCallback; }
+template<class SerialPort, class Settings, class Platform, class Handler> void MidiInterface<SerialPort, Settings, Platform, Handler>::setHandleTimeCodeQuarterFrame(Delegate<void(byte data)> inCallback)                           { Handler::mTimeCodeQuarterFrameCallback = inCallback; }
+template<class SerialPort, class Settings, class Platform, class Handler> void MidiInterface<SerialPort, Settings, Platform, Handler>::setHandleSongPosition(Delegate<void(unsigned beats)> inCallback)                              { Handler::mSongPositionCallback         = inCallback; }
+template<class SerialPort, class Settings, class Platform, class Handler> void MidiInterface<SerialPort, Settings, Platform, Handler>::setHandleSongSelect(Delegate<void(byte songnumber)> inCallback)                               { Handler::mSongSelectCallback           = inCallback; }
+template<class SerialPort, class Settings, class Platform, class Handler> void MidiInterface<SerialPort, Settings, Platform, Handler>::setHandleTuneRequest(Delegate<void()> inCallback)                                             { Handler::mTuneRequestCallback          = inCallback; }
+template<class SerialPort, class Settings, class Platform, class Handler> void MidiInterface<SerialPort, Settings, Platform, Handler>::setHandleClock(Delegate<void()> inCallback)                                                   { Handler::mClockCallback                = inCallback; }
+template<class SerialPort, class Settings, class Platform, class Handler> void MidiInterface<SerialPort, Settings, Platform, Handler>::setHandleStart(Delegate<void()> inCallback)                                                   { Handler::mStartCallback                = inCallback; }
+template<class SerialPort, class Settings, class Platform, class Handler> void MidiInterface<SerialPort, Settings, Platform, Handler>::setHandleContinue(Delegate<void()> inCallback)                                                { Handler::mContinueCallback             = inCallback; }
+template<class SerialPort, class Settings, class Platform, class Handler> void MidiInterface<SerialPort, Settings, Platform, Handler>::setHandleStop(Delegate<void()> inCallback)                                                    { Handler::mStopCallback                 = inCallback; }
+template<class SerialPort, class Settings, class Platform, class Handler> void MidiInterface<SerialPort, Settings, Platform, Handler>::setHandleActiveSensing(Delegate<void()> inCallback)                                           { Handler::mActiveSensingCallback        = inCallback; }
+template<class SerialPort, class Settings, class Platform, class Handler> void MidiInterface<SerialPort, Settings, Platform, Handler>::setHandleSystemReset(Delegate<void()> inCallback)                                             { Handler::mSystemResetCallback          = inCallback; }
 
 /*! \brief Detach an external function from the given type.
 
@@ -1162,29 +1774,30 @@ template<class SerialPort, class Settings> void MidiInterface<SerialPort, Settin
  \param inType        The type of message to unbind.
  When a message of this type is received, no function will be called.
  */
-template<class SerialPort, class Settings>
-void MidiInterface<SerialPort, Settings>::disconnectCallbackFromType(MidiType inType)
+template<class SerialPort, class Settings, class Platform, class Handler>
+void MidiInterface<SerialPort, Settings, Platform, Handler>::disconnectCallbackFromType(MidiType inType)
 {
     switch (inType)
     {
-        case NoteOff:               mNoteOffCallback                = 0; break;
-        case NoteOn:                mNoteOnCallback                 = 0; break;
-        case AfterTouchPoly:        mAfterTouchPolyCallback         = 0; break;
-        case ControlChange:         mControlChangeCallback          = 0; break;
-        case ProgramChange:         mProgramChangeCallback          = 0; break;
-        case AfterTouchChannel:     mAfterTouchChannelCallback      = 0; break;
-        case PitchBend:             mPitchBendCallback              = 0; break;
-        case SystemExclusive:       mSystemExclusiveCallback        = 0; break;
-        case TimeCodeQuarterFrame:  mTimeCodeQuarterFrameCallback   = 0; break;
-        case SongPosition:          mSongPositionCallback           = 0; break;
-        case SongSelect:            mSongSelectCallback             = 0; break;
-        case TuneRequest:           mTuneRequestCallback            = 0; break;
-        case Clock:                 mClockCallback                  = 0; break;
-        case Start:                 mStartCallback                  = 0; break;
-        case Continue:              mContinueCallback               = 0; break;
-        case Stop:                  mStopCallback                   = 0; break;
-        case ActiveSensing:         mActiveSensingCallback          = 0; break;
-        case SystemReset:           mSystemResetCallback            = 0; break;
+        case NoteOff:               Handler::mNoteOffCallback                = 0; break;
+        case NoteOn:                Handler::mNoteOnCallback                 = 0; break;
+        case AfterTouchPoly:        Handler::mAfterTouchPolyCallback         = 0; break;
+        case ControlChange:         Handler::mControlChangeCallback          = 0; break;
+        case ProgramChange:         Handler::mProgramChangeCallback          = 0; break;
+        case AfterTouchChannel:     Handler::mAfterTouchChannelCallback      = 0; break;
+        case PitchBend:             Handler::mPitchBendCallback              = 0; break;
+        case SystemExclusive:       Handler::mSystemExclusiveCallback        = 0;
+                                    Handler::mSystemExclusiveChunkCallback   = 0; break;
+        case TimeCodeQuarterFrame:  Handler::mTimeCodeQuarterFrameCallback   = 0; break;
+        case SongPosition:          Handler::mSongPositionCallback           = 0; break;
+        case SongSelect:            Handler::mSongSelectCallback             = 0; break;
+        case TuneRequest:           Handler::mTuneRequestCallback            = 0; break;
+        case Clock:                 Handler::mClockCallback                  = 0; break;
+        case Start:                 Handler::mStartCallback                  = 0; break;
+        case Continue:              Handler::mContinueCallback               = 0; break;
+        case Stop:                  Handler::mStopCallback                   = 0; break;
+        case ActiveSensing:         Handler::mActiveSensingCallback          = 0; break;
+        case SystemReset:           Handler::mSystemResetCallback            = 0; break;
         default:
             break;
     }
@@ -1192,40 +1805,66 @@ void MidiInterface<SerialPort, Settings>::disconnectCallbackFromType(MidiType in
 
 /*! @} */ // End of doc group MIDI Callbacks
 
+// Private method: position of the SysEx chunk held by mMessage.
+// Data bytes are below 0x80, so the boundaries tell where the chunk sits.
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline byte MidiInterface<SerialPort, Settings, Platform, Handler>::getSysExChunkFlags() const
+{
+    const unsigned size = mMessage.getSysExSize();
+    byte flags = SysExChunk::Continue;
+    if (size > 0 && mMessage.sysexArray[0] == SystemExclusive)
+    {
+        flags |= SysExChunk::Start;
+    }
+    if (size > 0 && mMessage.sysexArray[size - 1] == 0xf7)
+    {
+        flags |= SysExChunk::End;
+    }
+    return flags;
+}
+
 // Private - launch callback function based on received type.
-template<class SerialPort, class Settings>
-void MidiInterface<SerialPort, Settings>::launchCallback()
+template<class SerialPort, class Settings, class Platform, class Handler>
+void MidiInterface<SerialPort, Settings, Platform, Handler>::launchCallback()
 {
+    // Catch-all first: a single call whatever the number of handlers.
+    Handler::handleMessage(mMessage);
+
     // The order is mixed to allow frequent messages to trigger their callback faster.
     switch (mMessage.type)
     {
             // Notes
-        case NoteOff:               if (mNoteOffCallback != 0)               mNoteOffCallback(mMessage.channel, mMessage.data1, mMessage.data2);   break;
-        case NoteOn:                if (mNoteOnCallback != 0)                mNoteOnCallback(mMessage.channel, mMessage.data1, mMessage.data2);    break;
+        case NoteOff:               Handler::handleNoteOff(mMessage.channel, mMessage.data1, mMessage.data2); break;
+        case NoteOn:                Handler::handleNoteOn(mMessage.channel, mMessage.data1, mMessage.data2); break;
 
             // Real-time messages
-        case Clock:                 if (mClockCallback != 0)                 mClockCallback();           break;
-        case Start:                 if (mStartCallback != 0)                 mStartCallback();           break;
-        case Continue:              if (mContinueCallback != 0)              mContinueCallback();        break;
-        case Stop:                  if (mStopCallback != 0)                  mStopCallback();            break;
-        case ActiveSensing:         if (mActiveSensingCallback != 0)         mActiveSensingCallback();   break;
+        case Clock:                 Handler::handleClock(); break;
+        case Start:                 Handler::handleStart(); break;
+        case Continue:              Handler::handleContinue(); break;
+        case Stop:                  Handler::handleStop(); break;
+        case ActiveSensing:         Handler::handleActiveSensing(); break;
 
             // Continuous controllers
-        case ControlChange:         if (mControlChangeCallback != 0)         mControlChangeCallback(mMessage.channel, mMessage.data1, mMessage.data2);    break;
-        case PitchBend:             if (mPitchBendCallback != 0)             mPitchBendCallback(mMessage.channel, (int)((mMessage.data1 & 0x7f) | ((mMessage.data2 & 0x7f) << 7)) + MIDI_PITCHBEND_MIN); break; // TODO: check this
-        case AfterTouchPoly:        if (mAfterTouchPolyCallback != 0)        mAfterTouchPolyCallback(mMessage.channel, mMessage.data1, mMessage.data2);    break;
-        case AfterTouchChannel:     if (mAfterTouchChannelCallback != 0)     mAfterTouchChannelCallback(mMessage.channel, mMessage.data1);    break;
-
-        case ProgramChange:         if (mProgramChangeCallback != 0)         mProgramChangeCallback(mMessage.channel, mMessage.data1);    break;
-        case SystemExclusive:       if (mSystemExclusiveCallback != 0)       mSystemExclusiveCallback(mMessage.sysexArray, mMessage.getSysExSize());    break;
+        case ControlChange:         Handler::handleControlChange(mMessage.channel, mMessage.data1, mMessage.data2); break;
+        case PitchBend:             Handler::handlePitchBend(mMessage.channel, (int)((mMessage.data1 & 0x7f) | ((mMessage.data2 & 0x7f) << 7)) + MIDI_PITCHBEND_MIN); break; // TODO: check this
+        case AfterTouchPoly:        Handler::handleAfterTouchPoly(mMessage.channel, mMessage.data1, mMessage.data2); break;
+        case AfterTouchChannel:     Handler::handleAfterTouchChannel(mMessage.channel, mMessage.data1); break;
+
+        case ProgramChange:         Handler::handleProgramChange(mMessage.channel, mMessage.data1); break;
+        case SystemExclusive:
+            if (Handler::usesSysExChunks())
+                Handler::handleSystemExclusiveChunk(mMessage.sysexArray, mMessage.getSysExSize(), getSysExChunkFlags());
+            else
+                Handler::handleSystemExclusive(getSysExPayload(), getSysExArrayLength());
+            break;
 
             // Occasional messages
-        case TimeCodeQuarterFrame:  if (mTimeCodeQuarterFrameCallback != 0)  mTimeCodeQuarterFrameCallback(mMessage.data1);    break;
-        case SongPosition:          if (mSongPositionCallback != 0)          mSongPositionCallback((mMessage.data1 & 0x7f) | ((mMessage.data2 & 0x7f) << 7));    break;
-        case SongSelect:            if (mSongSelectCallback != 0)            mSongSelectCallback(mMessage.data1);    break;
-        case TuneRequest:           if (mTuneRequestCallback != 0)           mTuneRequestCallback();    break;
+        case TimeCodeQuarterFrame:  Handler::handleTimeCodeQuarterFrame(mMessage.data1); break;
+        case SongPosition:          Handler::handleSongPosition((mMessage.data1 & 0x7f) | ((mMessage.data2 & 0x7f) << 7)); break;
+        case SongSelect:            Handler::handleSongSelect(mMessage.data1); break;
+        case TuneRequest:           Handler::handleTuneRequest(); break;
 
-        case SystemReset:           if (mSystemResetCallback != 0)           mSystemResetCallback();    break;
+        case SystemReset:           Handler::handleSystemReset(); break;
 
         case InvalidType:
         default:
@@ -1248,39 +1887,66 @@ void MidiInterface<SerialPort, Settings>::launchCallback()
 
  @see Thru::Mode
  */
-template<class SerialPort, class Settings>
-inline void MidiInterface<SerialPort, Settings>::setThruFilterMode(Thru::Mode inThruFilterMode)
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline void MidiInterface<SerialPort, Settings, Platform, Handler>::setThruFilterMode(Thru::Mode inThruFilterMode)
 {
     mThruFilterMode = inThruFilterMode;
     mThruActivated  = mThruFilterMode != Thru::Off;
 }
 
-template<class SerialPort, class Settings>
-inline Thru::Mode MidiInterface<SerialPort, Settings>::getFilterMode() const
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline Thru::Mode MidiInterface<SerialPort, Settings, Platform, Handler>::getFilterMode() const
 {
     return mThruFilterMode;
 }
 
-template<class SerialPort, class Settings>
-inline bool MidiInterface<SerialPort, Settings>::getThruState() const
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline bool MidiInterface<SerialPort, Settings, Platform, Handler>::getThruState() const
 {
     return mThruActivated;
 }
 
-template<class SerialPort, class Settings>
-inline void MidiInterface<SerialPort, Settings>::turnThruOn(Thru::Mode inThruFilterMode)
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline void MidiInterface<SerialPort, Settings, Platform, Handler>::turnThruOn(Thru::Mode inThruFilterMode)
 {
     mThruActivated = true;
     mThruFilterMode = inThruFilterMode;
 }
 
-template<class SerialPort, class Settings>
-inline void MidiInterface<SerialPort, Settings>::turnThruOff()
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline void MidiInterface<SerialPort, Settings, Platform, Handler>::turnThruOff()
 {
     mThruActivated = false;
     mThruFilterMode = Thru::Off;
 }
 
+/*! \brief Send Thru to another destination as well, with its own filter.
+
+ The port of the interface keeps its own Thru settings.
+ @see ThruOutput
+ */
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline void MidiInterface<SerialPort, Settings, Platform, Handler>::addThruOutput(ThruOutput& inOutput)
+{
+    removeThruOutput(inOutput);
+    inOutput.mNext = mThruOutputs;
+    mThruOutputs = &inOutput;
+}
+
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline void MidiInterface<SerialPort, Settings, Platform, Handler>::removeThruOutput(ThruOutput& inOutput)
+{
+    for (ThruOutput** link = &mThruOutputs; *link != 0; link = &(*link)->mNext)
+    {
+        if (*link == &inOutput)
+        {
+            *link = inOutput.mNext;
+            inOutput.mNext = 0;
+            return;
+        }
+    }
+}
+
 /*! @} */ // End of doc group MIDI Thru
 
 // This method is called upon reception of a message
@@ -1289,89 +1955,140 @@ inline void MidiInterface<SerialPort, Settings>::turnThruOff()
 //   to output unless filter is set to Off.
 // - Channel messages are passed to the output whether their channel
 //   is matching the input channel and the filter setting
-template<class SerialPort, class Settings>
-void MidiInterface<SerialPort, Settings>::thruFilter(Channel inChannel)
+// The message is encoded once, the same bytes go to every destination.
+template<class SerialPort, class Settings, class Platform, class Handler>
+void MidiInterface<SerialPort, Settings, Platform, Handler>::thruFilter(Channel inChannel)
 {
+    // Cut-through: the bytes were forwarded to the port while parsing.
+    const bool toSerial = !Settings::UseCutThroughThru &&
+                          mThruActivated && mThruFilterMode != Thru::Off;
+
     // If the feature is disabled, don't do anything.
-    if (!mThruActivated || (mThruFilterMode == Thru::Off))
+    if (!toSerial && mThruOutputs == 0)
         return;
 
-    // First, check if the received message is Channel
-    if (mMessage.type >= NoteOff && mMessage.type <= PitchBend)
-    {
-        const bool filter_condition = ((mMessage.channel == inChannel) ||
-                                       (inChannel == MIDI_CHANNEL_OMNI));
+    byte buffer[3];
+    const byte* data = buffer;
+    unsigned size = 0;
+    byte status = mMessage.type;
 
-        // Now let's pass it to the output
-        switch (mThruFilterMode)
+    if (status == SystemExclusive)
+    {
+        // 0xf0 and 0xf7 are included in the buffer
+        data = getSysExArray();
+        size = getSysExArrayLength();
+    }
+    else
+    {
+        if (StatusTable::isChannelMessage(status))
         {
-            case Thru::Full:
-                send(mMessage.type,
-                     mMessage.data1,
-                     mMessage.data2,
-                     mMessage.channel);
-                break;
+            status = getStatus(mMessage.type, mMessage.channel);
+        }
+        buffer[0] = status;
+        buffer[1] = mMessage.data1;
+        buffer[2] = mMessage.data2;
+        size = StatusTable::getLength(status);
+    }
 
-            case Thru::SameChannel:
-                if (filter_condition)
+    if (toSerial && isThruAccepted(mThruFilterMode, status, inChannel))
+    {
+        unsigned start = 0;
+        if (StatusTable::isChannelMessage(status))
+        {
+            if (Settings::UseRunningStatus)
+            {
+                if (mRunningStatus_TX == status)
                 {
-                    send(mMessage.type,
-                         mMessage.data1,
-                         mMessage.data2,
-                         mMessage.channel);
+                    start = 1; // Omit the status byte
+                    mRunningStatusSavings++;
                 }
-                break;
+                mRunningStatus_TX = status;
+            }
+        }
+        else if (!StatusTable::isRealTime(status) && Settings::UseRunningStatus)
+        {
+            mRunningStatus_TX = InvalidType;
+        }
 
-            case Thru::DifferentChannel:
-                if (!filter_condition)
-                {
-                    send(mMessage.type,
-                         mMessage.data1,
-                         mMessage.data2,
-                         mMessage.channel);
-                }
-                break;
+        transmit(data + start, size - start);
+    }
 
-            default:
-                break;
+    thruToOutputs(data, size, status, inChannel);
+}
+
+// Private method: send an encoded message to the additional Thru outputs.
+template<class SerialPort, class Settings, class Platform, class Handler>
+void MidiInterface<SerialPort, Settings, Platform, Handler>::thruToOutputs(const byte* inData,
+                                                                         unsigned inSize,
+                                                                         byte inStatus,
+                                                                         Channel inChannel)
+{
+    for (ThruOutput* output = mThruOutputs; output != 0; output = output->mNext)
+    {
+        if (isThruAccepted(output->mFilterMode, inStatus, inChannel))
+        {
+            output->write(inData, inSize);
         }
     }
-    else
+}
+
+// Private method: does a filter mode let a message through?
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline bool MidiInterface<SerialPort, Settings, Platform, Handler>::isThruAccepted(Thru::Mode inMode,
+                                                                                 byte inStatus,
+                                                                                 Channel inChannel)
+{
+    if (inMode == Thru::Off)
+        return false;
+
+    if (!StatusTable::isChannelMessage(inStatus))
+        return true; // System messages
+
+    const bool match = getChannelFromStatusByte(inStatus) == inChannel ||
+                       inChannel == MIDI_CHANNEL_OMNI;
+    switch (inMode)
     {
-        // Send the message to the output
-        switch (mMessage.type)
-        {
-                // Real Time and 1 byte
-            case Clock:
-            case Start:
-            case Stop:
-            case Continue:
-            case ActiveSensing:
-            case SystemReset:
-            case TuneRequest:
-                sendRealTime(mMessage.type);
-                break;
+        case Thru::Full:                return true;
+        case Thru::SameChannel:         return match;
+        case Thru::DifferentChannel:    return !match;
+        default:                        return false;
+    }
+}
 
-            case SystemExclusive:
-                // Send SysEx (0xf0 and 0xf7 are included in the buffer)
-                sendSysEx(getSysExArrayLength(), getSysExArray(), true);
-                break;
+// Private method: cut-through Thru, forward a status byte starting a message.
+// The filter is applied here, the rest of the message follows the decision.
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline void MidiInterface<SerialPort, Settings, Platform, Handler>::thruStatus(byte inStatus)
+{
+    mThruForwarding = false;
+    if (!mThruActivated || !isThruAccepted(mThruFilterMode, inStatus, mInputChannel))
+        return;
 
-            case SongSelect:
-                sendSongSelect(mMessage.data1);
-                break;
+    // System Common messages cancel Running Status
+    mRunningStatus_TX = StatusTable::isChannelMessage(inStatus) ? inStatus : StatusByte(InvalidType);
 
-            case SongPosition:
-                sendSongPosition(mMessage.data1 | ((unsigned)mMessage.data2 << 7));
-                break;
+    mThruForwarding = true;
+    transmit(inStatus);
+}
 
-            case TimeCodeQuarterFrame:
-                sendTimeCodeQuarterFrame(mMessage.data1,mMessage.data2);
-                break;
+// Private method: cut-through Thru, forward a byte of the current message.
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline void MidiInterface<SerialPort, Settings, Platform, Handler>::thruData(byte inData)
+{
+    if (mThruForwarding)
+    {
+        transmit(inData);
+    }
+}
 
-            default:
-                break; // LCOV_EXCL_LINE - Unreacheable code, but prevents unhandled case warning.
-        }
+// Private method: cut-through Thru, forward a Real Time byte.
+// It does not interrupt the message being forwarded.
+template<class SerialPort, class Settings, class Platform, class Handler>
+inline void MidiInterface<SerialPort, Settings, Platform, Handler>::thruRealTime(byte inData)
+{
+    if (mThruActivated && mThruFilterMode != Thru::Off)
+    {
+        transmit(inData);
     }
 }
 
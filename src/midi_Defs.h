@@ -33,6 +33,7 @@
 #include <Arduino.h>
 #else
 #include <inttypes.h>
+#include <string.h>
 typedef uint8_t byte;
 #endif
 
@@ -99,6 +100,22 @@ struct Thru
     };
 };
 
+/*! Position of a received System Exclusive chunk within its message.
+ A message that fits in a single chunk has both Start and End flags.
+ @see MidiInterface::setHandleSystemExclusiveChunk
+ */
+struct SysExChunk
+{
+    enum Flags
+    {
+        Continue    = 0x00, ///< Neither the first nor the last chunk.
+        Start       = 0x01, ///< First chunk, starts with 0xf0.
+        End         = 0x02, ///< Last chunk, ends with 0xf7.
+    };
+};
+
+// -----------------------------------------------------------------------------
+
 /*! Deprecated: use Thru::Mode instead.
  Will be removed in v5.0.
 */
@@ -0,0 +1,350 @@
+/*!
+ *  @file       midi_Delegate.h
+ *  Project     Arduino MIDI Library
+ *  @brief      MIDI Library for the Arduino - Callbacks bound to objects
+ *  @author     Francois Best
+ *  @date       17/10/2026
+ *  @license    MIT - Copyright (c) 2026 Francois Best
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "midi_Namespace.h"
+
+BEGIN_MIDI_NAMESPACE
+
+/*! True when From converts implicitly to To, without C++11 type traits. */
+template<class From, class To>
+struct IsConvertible
+{
+    static char test(To);
+    static long test(...);
+    static From make();
+    static const bool value = sizeof(test(make())) == sizeof(char);
+};
+
+template<bool Condition>
+struct EnableIf
+{
+};
+
+template<>
+struct EnableIf<true>
+{
+    typedef void type;
+};
+
+// -----------------------------------------------------------------------------
+
+/*! \brief Callback holding either a plain function or an object and one of
+ its methods, in two pointers and without allocation.
+
+ Plain functions, and anything converting to them such as lambdas without
+ captures, convert implicitly, so existing callbacks keep working. They are
+ called directly, methods through a thunk bound at compile time:
+ \code{.cpp}
+ class Synth
+ {
+ public:
+     void noteOn(byte inChannel, byte inNote, byte inVelocity);
+ };
+ Synth synth;
+ MIDI.setHandleNoteOn(midi::Delegate<void(byte, byte, byte)>
+                      ::bind<Synth, &Synth::noteOn>(&synth));
+ \endcode
+ Only signatures returning void with up to 3 arguments are provided.
+ */
+template<class Signature>
+class Delegate;
+
+// -----------------------------------------------------------------------------
+
+template<>
+class Delegate<void()>
+{
+public:
+    typedef void (*Function)();
+
+    inline Delegate(Function inFunction = 0)
+        : mThunk(0)
+    {
+        mContext.function = inFunction;
+    }
+
+    template<class Callable>
+    inline Delegate(Callable inCallable,
+                    typename EnableIf<IsConvertible<Callable, Function>::value>::type* = 0)
+        : mThunk(0)
+    {
+        mContext.function = inCallable;
+    }
+
+    template<class T, void (T::*Method)()>
+    static inline Delegate bind(T* inObject)
+    {
+        Delegate delegate;
+        delegate.mContext.object = inObject;
+        delegate.mThunk = &callMethod<T, Method>;
+        return delegate;
+    }
+
+public:
+    inline bool isBound() const
+    {
+        return mThunk != 0 || mContext.function != 0;
+    }
+
+    inline void operator()() const
+    {
+        if (mThunk == 0)
+        {
+            mContext.function();
+        }
+        else
+        {
+            mThunk(mContext);
+        }
+    }
+
+private:
+    union Context
+    {
+        void* object;           ///< With mThunk, for methods.
+        Function function;      ///< Without, for plain functions.
+    };
+    typedef void (*Thunk)(const Context&);
+
+    template<class T, void (T::*Method)()>
+    static void callMethod(const Context& inContext)
+    {
+        (static_cast<T*>(inContext.object)->*Method)();
+    }
+
+private:
+    Context mContext;
+    Thunk mThunk;
+};
+
+// -----------------------------------------------------------------------------
+
+template<class A1>
+class Delegate<void(A1)>
+{
+public:
+    typedef void (*Function)(A1);
+
+    inline Delegate(Function inFunction = 0)
+        : mThunk(0)
+    {
+        mContext.function = inFunction;
+    }
+
+    template<class Callable>
+    inline Delegate(Callable inCallable,
+                    typename EnableIf<IsConvertible<Callable, Function>::value>::type* = 0)
+        : mThunk(0)
+    {
+        mContext.function = inCallable;
+    }
+
+    template<class T, void (T::*Method)(A1)>
+    static inline Delegate bind(T* inObject)
+    {
+        Delegate delegate;
+        delegate.mContext.object = inObject;
+        delegate.mThunk = &callMethod<T, Method>;
+        return delegate;
+    }
+
+public:
+    inline bool isBound() const
+    {
+        return mThunk != 0 || mContext.function != 0;
+    }
+
+    inline void operator()(A1 inArg1) const
+    {
+        if (mThunk == 0)
+        {
+            mContext.function(inArg1);
+        }
+        else
+        {
+            mThunk(mContext, inArg1);
+        }
+    }
+
+private:
+    union Context
+    {
+        void* object;           ///< With mThunk, for methods.
+        Function function;      ///< Without, for plain functions.
+    };
+    typedef void (*Thunk)(const Context&, A1);
+
+    template<class T, void (T::*Method)(A1)>
+    static void callMethod(const Context& inContext, A1 inArg1)
+    {
+        (static_cast<T*>(inContext.object)->*Method)(inArg1);
+    }
+
+private:
+    Context mContext;
+    Thunk mThunk;
+};
+
+// -----------------------------------------------------------------------------
+
+template<class A1, class A2>
+class Delegate<void(A1, A2)>
+{
+public:
+    typedef void (*Function)(A1, A2);
+
+    inline Delegate(Function inFunction = 0)
+        : mThunk(0)
+    {
+        mContext.function = inFunction;
+    }
+
+    template<class Callable>
+    inline Delegate(Callable inCallable,
+                    typename EnableIf<IsConvertible<Callable, Function>::value>::type* = 0)
+        : mThunk(0)
+    {
+        mContext.function = inCallable;
+    }
+
+    template<class T, void (T::*Method)(A1, A2)>
+    static inline Delegate bind(T* inObject)
+    {
+        Delegate delegate;
+        delegate.mContext.object = inObject;
+        delegate.mThunk = &callMethod<T, Method>;
+        return delegate;
+    }
+
+public:
+    inline bool isBound() const
+    {
+        return mThunk != 0 || mContext.function != 0;
+    }
+
+    inline void operator()(A1 inArg1, A2 inArg2) const
+    {
+        if (mThunk == 0)
+        {
+            mContext.function(inArg1, inArg2);
+        }
+        else
+        {
+            mThunk(mContext, inArg1, inArg2);
+        }
+    }
+
+private:
+    union Context
+    {
+        void* object;           ///< With mThunk, for methods.
+        Function function;      ///< Without, for plain functions.
+    };
+    typedef void (*Thunk)(const Context&, A1, A2);
+
+    template<class T, void (T::*Method)(A1, A2)>
+    static void callMethod(const Context& inContext, A1 inArg1, A2 inArg2)
+    {
+        (static_cast<T*>(inContext.object)->*Method)(inArg1, inArg2);
+    }
+
+private:
+    Context mContext;
+    Thunk mThunk;
+};
+
+// -----------------------------------------------------------------------------
+
+template<class A1, class A2, class A3>
+class Delegate<void(A1, A2, A3)>
+{
+public:
+    typedef void (*Function)(A1, A2, A3);
+
+    inline Delegate(Function inFunction = 0)
+        : mThunk(0)
+    {
+        mContext.function = inFunction;
+    }
+
+    template<class Callable>
+    inline Delegate(Callable inCallable,
+                    typename EnableIf<IsConvertible<Callable, Function>::value>::type* = 0)
+        : mThunk(0)
+    {
+        mContext.function = inCallable;
+    }
+
+    template<class T, void (T::*Method)(A1, A2, A3)>
+    static inline Delegate bind(T* inObject)
+    {
+        Delegate delegate;
+        delegate.mContext.object = inObject;
+        delegate.mThunk = &callMethod<T, Method>;
+        return delegate;
+    }
+
+public:
+    inline bool isBound() const
+    {
+        return mThunk != 0 || mContext.function != 0;
+    }
+
+    inline void operator()(A1 inArg1, A2 inArg2, A3 inArg3) const
+    {
+        if (mThunk == 0)
+        {
+            mContext.function(inArg1, inArg2, inArg3);
+        }
+        else
+        {
+            mThunk(mContext, inArg1, inArg2, inArg3);
+        }
+    }
+
+private:
+    union Context
+    {
+        void* object;           ///< With mThunk, for methods.
+        Function function;      ///< Without, for plain functions.
+    };
+    typedef void (*Thunk)(const Context&, A1, A2, A3);
+
+    template<class T, void (T::*Method)(A1, A2, A3)>
+    static void callMethod(const Context& inContext, A1 inArg1, A2 inArg2, A3 inArg3)
+    {
+        (static_cast<T*>(inContext.object)->*Method)(inArg1, inArg2, inArg3);
+    }
+
+private:
+    Context mContext;
+    Thunk mThunk;
+};
+
+END_MIDI_NAMESPACE
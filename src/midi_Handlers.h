@@ -0,0 +1,146 @@
+/*!
+ *  @file       midi_Handlers.h
+ *  Project     Arduino MIDI Library
+ *  @brief      MIDI Library for the Arduino - Input handler policies
+ *  @author     Francois Best
+ *  @date       17/10/2026
+ *  @license    MIT - Copyright (c) 2026 Francois Best
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "midi_Defs.h"
+#include "midi_Delegate.h"
+
+BEGIN_MIDI_NAMESPACE
+
+/*! \brief Handler policy calling the functions or delegates registered with
+ the setHandle... methods of MidiInterface. This is the default.
+ */
+template<class MessageType>
+class CallbackHandler
+{
+protected:
+    inline void handleMessage(const MessageType& inMessage)                              { if (mMessageCallback.isBound())                   mMessageCallback(inMessage); }
+    inline void handleNoteOff(byte inChannel, byte inNote, byte inVelocity)              { if (mNoteOffCallback.isBound())                   mNoteOffCallback(inChannel, inNote, inVelocity); }
+    inline void handleNoteOn(byte inChannel, byte inNote, byte inVelocity)               { if (mNoteOnCallback.isBound())                    mNoteOnCallback(inChannel, inNote, inVelocity); }
+    inline void handleAfterTouchPoly(byte inChannel, byte inNote, byte inPressure)       { if (mAfterTouchPolyCallback.isBound())            mAfterTouchPolyCallback(inChannel, inNote, inPressure); }
+    inline void handleControlChange(byte inChannel, byte inNumber, byte inValue)         { if (mControlChangeCallback.isBound())             mControlChangeCallback(inChannel, inNumber, inValue); }
+    inline void handleProgramChange(byte inChannel, byte inNumber)                       { if (mProgramChangeCallback.isBound())             mProgramChangeCallback(inChannel, inNumber); }
+    inline void handleAfterTouchChannel(byte inChannel, byte inPressure)                 { if (mAfterTouchChannelCallback.isBound())         mAfterTouchChannelCallback(inChannel, inPressure); }
+    inline void handlePitchBend(byte inChannel, int inBend)                              { if (mPitchBendCallback.isBound())                 mPitchBendCallback(inChannel, inBend); }
+    inline void handleSystemExclusive(byte* inArray, unsigned inSize)                    { if (mSystemExclusiveCallback.isBound())           mSystemExclusiveCallback(inArray, inSize); }
+    inline void handleSystemExclusiveChunk(byte* inArray, unsigned inSize, byte inFlags) { if (mSystemExclusiveChunkCallback.isBound())      mSystemExclusiveChunkCallback(inArray, inSize, inFlags); }
+    inline void handleTimeCodeQuarterFrame(byte inData)                                  { if (mTimeCodeQuarterFrameCallback.isBound())      mTimeCodeQuarterFrameCallback(inData); }
+    inline void handleSongPosition(unsigned inBeats)                                     { if (mSongPositionCallback.isBound())              mSongPositionCallback(inBeats); }
+    inline void handleSongSelect(byte inSongNumber)                                      { if (mSongSelectCallback.isBound())                mSongSelectCallback(inSongNumber); }
+    inline void handleTuneRequest()                                                      { if (mTuneRequestCallback.isBound())               mTuneRequestCallback(); }
+    inline void handleClock()                                                            { if (mClockCallback.isBound())                     mClockCallback(); }
+    inline void handleStart()                                                            { if (mStartCallback.isBound())                     mStartCallback(); }
+    inline void handleContinue()                                                         { if (mContinueCallback.isBound())                  mContinueCallback(); }
+    inline void handleStop()                                                             { if (mStopCallback.isBound())                      mStopCallback(); }
+    inline void handleActiveSensing()                                                    { if (mActiveSensingCallback.isBound())             mActiveSensingCallback(); }
+    inline void handleSystemReset()                                                      { if (mSystemResetCallback.isBound())               mSystemResetCallback(); }
+
+    /*! SysEx is handed over in chunks when a chunk callback is registered. */
+    inline bool usesSysExChunks() const
+    {
+        return mSystemExclusiveChunkCallback.isBound();
+    }
+
+protected:
+    Delegate<void(const MessageType& message)>                  mMessageCallback;
+    Delegate<void(byte channel, byte note, byte velocity)>      mNoteOffCallback;
+    Delegate<void(byte channel, byte note, byte velocity)>      mNoteOnCallback;
+    Delegate<void(byte channel, byte note, byte pressure)>      mAfterTouchPolyCallback;
+    Delegate<void(byte channel, byte number, byte value)>       mControlChangeCallback;
+    Delegate<void(byte channel, byte number)>                   mProgramChangeCallback;
+    Delegate<void(byte channel, byte pressure)>                 mAfterTouchChannelCallback;
+    Delegate<void(byte channel, int bend)>                      mPitchBendCallback;
+    Delegate<void(byte* array, unsigned size)>                  mSystemExclusiveCallback;
+    Delegate<void(byte* array, unsigned size, byte flags)>      mSystemExclusiveChunkCallback;
+    Delegate<void(byte data)>                                   mTimeCodeQuarterFrameCallback;
+    Delegate<void(unsigned beats)>                              mSongPositionCallback;
+    Delegate<void(byte songnumber)>                             mSongSelectCallback;
+    Delegate<void()>                                            mTuneRequestCallback;
+    Delegate<void()>                                            mClockCallback;
+    Delegate<void()>                                            mStartCallback;
+    Delegate<void()>                                            mContinueCallback;
+    Delegate<void()>                                            mStopCallback;
+    Delegate<void()>                                            mActiveSensingCallback;
+    Delegate<void()>                                            mSystemResetCallback;
+};
+
+// -----------------------------------------------------------------------------
+
+/*! \brief Static handler policy, resolved at compile time.
+
+ Derive from it and declare static methods with the same signature as the
+ handlers you need, they hide the empty ones below. The calls are direct and
+ can be inlined in the parser, unused handlers cost neither RAM nor branches.
+ The setHandle... methods of MidiInterface are not available with it.
+ \code{.cpp}
+ struct MyHandler : public midi::StaticHandler
+ {
+     static void handleNoteOn(byte inChannel, byte inNote, byte inVelocity)
+     {
+         digitalWrite(LED_BUILTIN, HIGH);
+     }
+ };
+ midi::MidiInterface<HardwareSerial, midi::DefaultSettings,
+                     midi::DefaultPlatform, MyHandler> MIDI(Serial);
+ \endcode
+ handleMessage(const midi::Message<SysExMaxSize>&) is called for every
+ message before the handler of its type.
+ Define usesSysExChunks() to return true to receive SysEx frames in chunks
+ with handleSystemExclusiveChunk.
+ */
+struct StaticHandler
+{
+    template<class MessageType>
+    static inline void handleMessage(const MessageType&)                { }
+    static inline void handleNoteOff(byte, byte, byte)                  { }
+    static inline void handleNoteOn(byte, byte, byte)                   { }
+    static inline void handleAfterTouchPoly(byte, byte, byte)           { }
+    static inline void handleControlChange(byte, byte, byte)            { }
+    static inline void handleProgramChange(byte, byte)                  { }
+    static inline void handleAfterTouchChannel(byte, byte)              { }
+    static inline void handlePitchBend(byte, int)                       { }
+    static inline void handleSystemExclusive(byte*, unsigned)           { }
+    static inline void handleSystemExclusiveChunk(byte*, unsigned, byte){ }
+    static inline void handleTimeCodeQuarterFrame(byte)                 { }
+    static inline void handleSongPosition(unsigned)                     { }
+    static inline void handleSongSelect(byte)                           { }
+    static inline void handleTuneRequest()                              { }
+    static inline void handleClock()                                    { }
+    static inline void handleStart()                                    { }
+    static inline void handleContinue()                                 { }
+    static inline void handleStop()                                     { }
+    static inline void handleActiveSensing()                            { }
+    static inline void handleSystemReset()                              { }
+
+    static inline bool usesSysExChunks()
+    {
+        return false;
+    }
+};
+
+END_MIDI_NAMESPACE
@@ -29,14 +29,83 @@
 
 #include "midi_Namespace.h"
 #include "midi_Defs.h"
+#include "midi_StatusTable.h"
 
 BEGIN_MIDI_NAMESPACE
 
+/*! Compact form of a message, 4 bytes long: cheap to copy, queue or log.
+ The payload of a SysEx message is not included, it lives in separate
+ storage; its size is held in data1 (LSB) and data2 (MSB).
+ */
+struct ShortMessage
+{
+    enum Flags
+    {
+        Valid = 0x01,   ///< The message respects the MIDI norm.
+    };
+
+    /*! Status byte, including the channel for channel messages. */
+    StatusByte status;
+    DataByte data1;
+    DataByte data2;
+    byte flags;
+
+    inline MidiType getType() const
+    {
+        return StatusTable::getType(status);
+    }
+
+    /*! From 1 to 16 for channel messages, 0 for system messages. */
+    inline Channel getChannel() const
+    {
+        return StatusTable::isChannelMessage(status) ? (status & 0x0f) + 1 : 0;
+    }
+
+    inline bool isValid() const
+    {
+        return flags & Valid;
+    }
+
+    inline unsigned getSysExSize() const
+    {
+        return unsigned(data2) << 8 | data1;
+    }
+};
+
+/*! Time when a message was received, see DefaultSettings::UseReceiveTimestamps.
+ */
+template<bool Enabled>
+struct MessageTimestamp
+{
+    inline MessageTimestamp()
+        : timestamp(0)
+    {
+    }
+
+    /*! Time when the first byte of the message was parsed,
+     in Platform::now() units.
+     */
+    unsigned long timestamp;
+
+    inline unsigned long getTimestamp() const       { return timestamp; }
+    inline void setTimestamp(unsigned long inTime)  { timestamp = inTime; }
+};
+
+/*! Timestamps compiled out: no storage, and the time is always 0. */
+template<>
+struct MessageTimestamp<false>
+{
+    inline unsigned long getTimestamp() const       { return 0; }
+    inline void setTimestamp(unsigned long)         { }
+};
+
+// -----------------------------------------------------------------------------
+
 /*! The Message structure contains decoded data of a MIDI message
     read from the serial port with read()
  */
-template<unsigned SysExMaxSize>
-struct Message
+template<unsigned SysExMaxSize, bool UseTimestamps = false>
+struct Message : public MessageTimestamp<UseTimestamps>
 {
     /*! Default constructor
      \n Initializes the attributes with their default values.
@@ -48,13 +117,16 @@ struct Message
         , data2(0)
         , valid(false)
     {
-        memset(sysexArray, 0, sSysExMaxSize * sizeof(DataByte));
     }
 
     /*! The maximum size for the System Exclusive array.
     */
     static const unsigned sSysExMaxSize = SysExMaxSize;
 
+    /*! Whether the message holds its receive time.
+    */
+    static const bool sHasTimestamp = UseTimestamps;
+
     /*! The MIDI channel on which the message was recieved.
      \n Value goes from 1 to 16.
      */
@@ -93,6 +165,29 @@ struct Message
         const unsigned size = unsigned(data2) << 8 | data1;
         return size > sSysExMaxSize ? sSysExMaxSize : size;
     }
+
+    /*! Compact copy of the message, without the SysEx payload. */
+    inline ShortMessage getShortMessage() const
+    {
+        ShortMessage message;
+        message.status  = byte(StatusTable::isChannelMessage(type) ? type | ((channel - 1) & 0x0f) : type);
+        message.data1   = data1;
+        message.data2   = data2;
+        message.flags   = valid ? ShortMessage::Valid : 0;
+        return message;
+    }
+
+    /*! Restore the message from its compact copy, the SysEx payload is left
+     untouched.
+     */
+    inline void setShortMessage(const ShortMessage& inMessage)
+    {
+        type    = inMessage.getType();
+        channel = inMessage.getChannel();
+        data1   = inMessage.data1;
+        data2   = inMessage.data2;
+        valid   = inMessage.isValid();
+    }
 };
 
 END_MIDI_NAMESPACE
@@ -0,0 +1,196 @@
+/*!
+ *  @file       midi_MessageQueue.h
+ *  Project     Arduino MIDI Library
+ *  @brief      MIDI Library for the Arduino - Decoded message queue
+ *  @author     Francois Best
+ *  @date       17/10/2026
+ *  @license    MIT - Copyright (c) 2026 Francois Best
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "midi_Defs.h"
+#include "midi_Message.h"
+#include "midi_RingBuffer.h"
+
+BEGIN_MIDI_NAMESPACE
+
+/*! Smallest power of two greater than or equal to Value. */
+template<unsigned Value, unsigned Power = 1, bool Done = (Power >= Value)>
+struct PowerOfTwoAbove
+{
+    static const unsigned value = PowerOfTwoAbove<Value, Power * 2>::value;
+};
+
+template<unsigned Value, unsigned Power>
+struct PowerOfTwoAbove<Value, Power, true>
+{
+    static const unsigned value = Power;
+};
+
+// -----------------------------------------------------------------------------
+
+/*! Receive times of the queued messages, alongside their compact form. */
+template<bool Enabled, int Size>
+class TimestampBuffer
+{
+public:
+    inline void write(unsigned long inTime)     { mBuffer.write(inTime); }
+    inline unsigned long read()                 { return mBuffer.read(); }
+    inline void clear()                         { mBuffer.clear(); }
+
+private:
+    RingBuffer<unsigned long, Size> mBuffer;
+};
+
+/*! Timestamps compiled out, no storage is reserved. */
+template<int Size>
+class TimestampBuffer<false, Size>
+{
+public:
+    inline void write(unsigned long)            { }
+    inline unsigned long read()                 { return 0; }
+    inline void clear()                         { }
+};
+
+// -----------------------------------------------------------------------------
+
+/*! \brief Fixed-capacity FIFO of decoded messages.
+
+ The parser completes messages in a workspace of its own, then pushes a copy,
+ so the message handed to the application is never overwritten before it is
+ consumed. Messages can be pushed from an interrupt and popped from the main
+ loop. See DefaultSettings::MessageQueueSize.
+
+ Messages are queued in their 4-byte ShortMessage form, SysEx payloads go to
+ a separate byte buffer that can hold two of the largest ones, and receive
+ times (when enabled) to a third one.
+ */
+template<class MessageType, unsigned Capacity>
+class MessageQueue
+    : private TimestampBuffer<MessageType::sHasTimestamp, PowerOfTwoAbove<Capacity>::value>
+{
+private:
+    // Empty base when timestamps are compiled out.
+    typedef TimestampBuffer<MessageType::sHasTimestamp, PowerOfTwoAbove<Capacity>::value> Timestamps;
+
+public:
+    inline MessageType& getWorkspace(MessageType&)
+    {
+        return mWorkspace;
+    }
+
+    inline unsigned getLength() const
+    {
+        return unsigned(mBuffer.getLength());
+    }
+
+    inline bool isEmpty() const
+    {
+        return mBuffer.isEmpty();
+    }
+
+    /*! Full when the next message might not fit, whatever its size. */
+    inline bool isFull() const
+    {
+        return getLength() >= Capacity ||
+               SysExBufferSize - unsigned(mSysExBuffer.getLength()) < MessageType::sSysExMaxSize;
+    }
+
+    /*! Append the workspace to the queue. Always succeeds when isFull was
+     false, otherwise the message is dropped if it does not fit.
+     */
+    inline bool push()
+    {
+        if (getLength() >= Capacity)
+        {
+            return false;
+        }
+        if (mWorkspace.type == SystemExclusive)
+        {
+            // Payload first, so it is there when the message is seen.
+            const int size = int(mWorkspace.getSysExSize());
+            if (int(SysExBufferSize) - mSysExBuffer.getLength() < size)
+            {
+                return false;
+            }
+            mSysExBuffer.write(mWorkspace.sysexArray, size);
+        }
+        // Time before the message too, pop() reads them together.
+        Timestamps::write(mWorkspace.getTimestamp());
+        mBuffer.write(mWorkspace.getShortMessage());
+        return true;
+    }
+
+    inline bool pop(MessageType& outMessage)
+    {
+        if (mBuffer.isEmpty())
+        {
+            return false;
+        }
+        // The slot is handed back last, once its time and payload are read,
+        // so a push from an interrupt cannot overwrite them.
+        outMessage.setShortMessage(mBuffer.peek());
+        outMessage.setTimestamp(Timestamps::read());
+        if (outMessage.type == SystemExclusive)
+        {
+            mSysExBuffer.read(outMessage.sysexArray, int(outMessage.getSysExSize()));
+        }
+        mBuffer.commitRead(1);
+        return true;
+    }
+
+    inline void clear()
+    {
+        mBuffer.clear();
+        mSysExBuffer.clear();
+        Timestamps::clear();
+    }
+
+private:
+    static const unsigned SysExBufferSize = PowerOfTwoAbove<2 * MessageType::sSysExMaxSize>::value;
+
+    RingBuffer<ShortMessage, PowerOfTwoAbove<Capacity>::value> mBuffer;
+    RingBuffer<byte, SysExBufferSize> mSysExBuffer;
+    MessageType mWorkspace;
+};
+
+/*! Disabled queue: the parser works in the application's message directly,
+ and no storage is reserved.
+ */
+template<class MessageType>
+class MessageQueue<MessageType, 0>
+{
+public:
+    inline MessageType& getWorkspace(MessageType& inMessage)
+    {
+        return inMessage;
+    }
+
+    inline unsigned getLength() const   { return 0; }
+    inline bool isEmpty() const         { return true; }
+    inline bool isFull() const          { return false; }
+    inline bool push()                  { return true; }
+    inline bool pop(MessageType&)       { return false; }
+    inline void clear()                 { }
+};
+
+END_MIDI_NAMESPACE
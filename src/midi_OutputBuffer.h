@@ -0,0 +1,127 @@
+/*!
+ *  @file       midi_OutputBuffer.h
+ *  Project     Arduino MIDI Library
+ *  @brief      MIDI Library for the Arduino - Output staging buffer
+ *  @author     Francois Best
+ *  @date       17/10/2026
+ *  @license    MIT - Copyright (c) 2026 Francois Best
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "midi_Defs.h"
+
+BEGIN_MIDI_NAMESPACE
+
+/*! \brief Collects encoded output bytes, to hand them over to the port with
+ a single write(const byte*, n) call.
+
+ The buffer is flushed when the next byte does not fit, or on demand. Blocks
+ larger than the buffer go to the port directly, after the pending bytes.
+ See DefaultSettings::OutputBufferSize.
+ */
+template<unsigned Size>
+class OutputBuffer
+{
+public:
+    inline OutputBuffer()
+        : mLength(0)
+    {
+    }
+
+    template<class SerialPort>
+    inline void write(SerialPort& inSerial, byte inData)
+    {
+        if (mLength >= Size)
+        {
+            flush(inSerial);
+        }
+        mData[mLength++] = inData;
+    }
+
+    template<class SerialPort>
+    inline void write(SerialPort& inSerial, const byte* inData, unsigned inSize)
+    {
+        if (inSize >= Size)
+        {
+            flush(inSerial);
+            inSerial.write(inData, inSize);
+            return;
+        }
+        if (Size - mLength < inSize)
+        {
+            flush(inSerial);
+        }
+        for (unsigned i = 0; i < inSize; ++i)
+        {
+            mData[mLength + i] = inData[i];
+        }
+        mLength += inSize;
+    }
+
+    template<class SerialPort>
+    inline void flush(SerialPort& inSerial)
+    {
+        if (mLength > 0)
+        {
+            inSerial.write(mData, mLength);
+            mLength = 0;
+        }
+    }
+
+    inline unsigned getLength() const   { return mLength; }
+    inline void clear()                 { mLength = 0; }
+
+private:
+    byte mData[Size];
+    unsigned mLength;
+};
+
+/*! Disabled buffer: bytes are written to the port one at a time, and the
+ port does not need a write(const byte*, n) method.
+ */
+template<>
+class OutputBuffer<0>
+{
+public:
+    template<class SerialPort>
+    inline void write(SerialPort& inSerial, byte inData)
+    {
+        inSerial.write(inData);
+    }
+
+    template<class SerialPort>
+    inline void write(SerialPort& inSerial, const byte* inData, unsigned inSize)
+    {
+        for (unsigned i = 0; i < inSize; ++i)
+        {
+            inSerial.write(inData[i]);
+        }
+    }
+
+    template<class SerialPort>
+    inline void flush(SerialPort&)      { }
+
+    inline unsigned getLength() const   { return 0; }
+    inline void clear()                 { }
+};
+
+END_MIDI_NAMESPACE
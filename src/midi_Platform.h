@@ -0,0 +1,83 @@
+/*!
+ *  @file       midi_Platform.h
+ *  Project     Arduino MIDI Library
+ *  @brief      MIDI Library for the Arduino - Platform services
+ *  @author     Francois Best
+ *  @date       17/10/2026
+ *  @license    MIT - Copyright (c) 2026 Francois Best
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "midi_Defs.h"
+
+// POSIX clock for host builds. Other targets without Arduino (eg: AVR_CAKE
+// on avr-libc) have no clock the library knows of.
+#if !ARDUINO && !defined(AVR_CAKE) && (defined(__unix__) || defined(__APPLE__))
+#define MIDI_PLATFORM_POSIX_CLOCK 1
+#include <time.h>
+#endif
+
+BEGIN_MIDI_NAMESPACE
+
+/*! \brief Default platform services for the MIDI Library.
+
+ The platform provides the time base used by the library, in microseconds.
+ To use another clock (eg: a hardware timer, or a fake clock in tests),
+ create a struct with a static now() method and pass it as the Platform
+ template argument of MidiInterface:
+ \code{.cpp}
+ struct MyPlatform
+ {
+    static unsigned long now() { return myTimerMicros(); }
+ };
+
+ midi::MidiInterface<HardwareSerial, midi::DefaultSettings, MyPlatform> MIDI(Serial);
+ \endcode
+ The clock is expected to wrap around, durations are computed with unsigned
+ subtraction. The default uses micros() on Arduino, the POSIX monotonic clock
+ on host builds, and needs to be replaced on other targets (see now()).
+ */
+struct DefaultPlatform
+{
+#if ARDUINO
+    static inline unsigned long now()
+    {
+        return ::micros();
+    }
+#elif defined(MIDI_PLATFORM_POSIX_CLOCK)
+    static inline unsigned long now()
+    {
+        timespec time;
+        clock_gettime(CLOCK_MONOTONIC, &time);
+        return (unsigned long)time.tv_sec * 1000000ul + time.tv_nsec / 1000;
+    }
+#else
+    /*! Not defined: without Arduino nor POSIX, the features using the time
+     (receive timestamps, latency statistics, readFor, Scheduler and
+     SmfPlayer) fail to link on midi::DefaultPlatform::now(), and require a
+     Platform supplied by the application. Everything else works without.
+     */
+    static unsigned long now();
+#endif
+};
+
+END_MIDI_NAMESPACE
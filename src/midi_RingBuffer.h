@@ -28,12 +28,59 @@
 #pragma once
 
 #include "midi_Namespace.h"
+#include "midi_Defs.h"
 
 BEGIN_MIDI_NAMESPACE
 
+// Order memory accesses around index updates. A compiler barrier is enough
+// on single-core AVR (interrupt vs main loop), other targets get an
+// acquire-release fence (free on x86, a dmb on ARM).
+#if defined(__AVR__)
+#define MIDI_MEMORY_BARRIER()   __asm__ __volatile__ ("" ::: "memory")
+#else
+#define MIDI_MEMORY_BARRIER()   __atomic_thread_fence(__ATOMIC_ACQ_REL)
+#endif
+
+/*! Indices wrap freely and are masked on access: byte indices (loaded and
+ stored atomically on 8-bit targets) can count up to 2 * Size for Size <= 128.
+ */
+template<bool IsSmall>
+struct RingBufferIndex
+{
+    typedef unsigned Type;
+};
+
+template<>
+struct RingBufferIndex<true>
+{
+    typedef byte Type;
+};
+
+/*! \brief Fixed-size FIFO, lock-free for one producer and one consumer.
+
+ One context (eg: an interrupt, a thread) may write while another one reads,
+ without locking: each index is only updated by its own side, after the data
+ it publishes. Size must be a power of two, all Size slots are usable.
+ getLength(), isEmpty() and isFull() can be called from either side.
+
+ Bulk operations copy at most two contiguous segments. Spans give direct
+ access to the storage, so a producer can receive in place (eg: a DMA
+ transfer) and a consumer can send from it, without intermediate copies:
+ \code{.cpp}
+ int size = 0;
+ byte* span = buffer.getWriteSpan(size);
+ buffer.commitWrite(receive(span, size));
+ \endcode
+ DataType must be trivially copyable.
+ */
 template<typename DataType, int Size>
 class RingBuffer
 {
+private:
+    typedef typename RingBufferIndex<(Size <= 128)>::Type Index;
+    typedef char SizeMustBeAPowerOfTwo[(Size > 0 && (Size & (Size - 1)) == 0) ? 1 : -1];
+    static const Index sMask = Size - 1;
+
 public:
      RingBuffer();
     ~RingBuffer();
@@ -41,20 +88,26 @@ public:
 public:
     int getLength() const;
     bool isEmpty() const;
+    bool isFull() const;
 
-public:
-    void write(DataType inData);
-    void write(const DataType* inData, int inSize);
-    void clear();
+public: // Producer side
+    bool write(DataType inData);
+    int write(const DataType* inData, int inSize);
+    DataType* getWriteSpan(int& outSize);
+    void commitWrite(int inSize);
 
-public:
+public: // Consumer side
+    DataType peek() const;
     DataType read();
-    void read(DataType* outData, int inSize);
+    int read(DataType* outData, int inSize);
+    const DataType* getReadSpan(int& outSize) const;
+    void commitRead(int inSize);
+    void clear();
 
 private:
     DataType mData[Size];
-    DataType* mWriteHead;
-    DataType* mReadHead;
+    volatile Index mWriteIndex;
+    volatile Index mReadIndex;
 };
 
 END_MIDI_NAMESPACE
@@ -31,10 +31,9 @@ BEGIN_MIDI_NAMESPACE
 
 template<typename DataType, int Size>
 RingBuffer<DataType, Size>::RingBuffer()
-    : mWriteHead(mData)
-    , mReadHead(mData)
+    : mWriteIndex(0)
+    , mReadIndex(0)
 {
-    memset(mData, DataType(0), Size * sizeof(DataType));
 }
 
 template<typename DataType, int Size>
@@ -47,75 +46,176 @@ RingBuffer<DataType, Size>::~RingBuffer()
 template<typename DataType, int Size>
 int RingBuffer<DataType, Size>::getLength() const
 {
-    if (mReadHead == mWriteHead)
-    {
-        return 0;
-    }
-    else if (mWriteHead > mReadHead)
-    {
-        return int(mWriteHead - mReadHead);
-    }
-    else
-    {
-        return int(mWriteHead - mData) + Size - int(mReadHead - mData);
-    }
+    return int(Index(mWriteIndex - mReadIndex));
 }
 
 template<typename DataType, int Size>
 bool RingBuffer<DataType, Size>::isEmpty() const
 {
-    return mReadHead == mWriteHead;
+    return mWriteIndex == mReadIndex;
+}
+
+template<typename DataType, int Size>
+bool RingBuffer<DataType, Size>::isFull() const
+{
+    return getLength() >= Size;
 }
 
 // -----------------------------------------------------------------------------
 
+/*! \brief Append an element.
+ \return false when the buffer is full: the element is dropped.
+ */
 template<typename DataType, int Size>
-void RingBuffer<DataType, Size>::write(DataType inData)
+bool RingBuffer<DataType, Size>::write(DataType inData)
 {
-    *mWriteHead++ = inData;
-    if (mWriteHead >= mData + Size)
+    const Index writeIndex = mWriteIndex;
+    if (Index(writeIndex - mReadIndex) >= Index(Size))
     {
-        mWriteHead = mData;
+        return false; // Overflow
     }
+
+    // The slot must be free (read index loaded) before it is written,
+    // and written before it is published.
+    MIDI_MEMORY_BARRIER();
+    mData[writeIndex & sMask] = inData;
+    MIDI_MEMORY_BARRIER();
+    mWriteIndex = writeIndex + 1;
+    return true;
+}
+
+/*! \brief Append elements, as many as fit.
+ \return The number of elements written.
+ */
+template<typename DataType, int Size>
+int RingBuffer<DataType, Size>::write(const DataType* inData, int inSize)
+{
+    const Index writeIndex  = mWriteIndex;
+    const int available     = Size - int(Index(writeIndex - mReadIndex));
+    const int count         = inSize < available ? inSize : available;
+    const int offset        = writeIndex & sMask;
+    const int first         = count < Size - offset ? count : Size - offset;
+
+    MIDI_MEMORY_BARRIER();
+    memcpy(static_cast<void*>(mData + offset), inData, first * sizeof(DataType));
+    memcpy(static_cast<void*>(mData), inData + first, (count - first) * sizeof(DataType));
+    MIDI_MEMORY_BARRIER();
+    mWriteIndex = writeIndex + count;
+    return count;
 }
 
+/*! \brief Get the contiguous free space following the written elements.
+ \param outSize Number of elements that can be written in the span,
+ 0 when the buffer is full.
+ @see commitWrite to publish the elements written in the span.
+ */
 template<typename DataType, int Size>
-void RingBuffer<DataType, Size>::write(const DataType* inData, int inSize)
+DataType* RingBuffer<DataType, Size>::getWriteSpan(int& outSize)
 {
-    for (int i = 0; i < inSize; ++i)
-    {
-        write(inData[i]);
-    }
+    const Index writeIndex  = mWriteIndex;
+    const int available     = Size - int(Index(writeIndex - mReadIndex));
+    const int offset        = writeIndex & sMask;
+
+    outSize = available < Size - offset ? available : Size - offset;
+    MIDI_MEMORY_BARRIER();
+    return mData + offset;
 }
 
+/*! \brief Publish inSize elements written in the span from getWriteSpan. */
 template<typename DataType, int Size>
-void RingBuffer<DataType, Size>::clear()
+void RingBuffer<DataType, Size>::commitWrite(int inSize)
 {
-    memset(mData, DataType(0), Size * sizeof(DataType));
-    mReadHead  = mData;
-    mWriteHead = mData;
+    MIDI_MEMORY_BARRIER();
+    mWriteIndex = mWriteIndex + inSize;
 }
 
 // -----------------------------------------------------------------------------
 
+/*! \brief Get the oldest element, without taking it out.
+ Check for isEmpty first: peeking an empty buffer returns a default element.
+ */
 template<typename DataType, int Size>
-DataType RingBuffer<DataType, Size>::read()
+DataType RingBuffer<DataType, Size>::peek() const
 {
-    const DataType data = *mReadHead++;
-    if (mReadHead >= mData + Size)
+    const Index readIndex = mReadIndex;
+    if (readIndex == mWriteIndex)
     {
-        mReadHead = mData;
+        return DataType();
     }
-    return data;
+    MIDI_MEMORY_BARRIER();
+    return mData[readIndex & sMask];
 }
 
+/*! \brief Take the oldest element out.
+ Check for isEmpty first: reading an empty buffer returns a default element.
+ */
 template<typename DataType, int Size>
-void RingBuffer<DataType, Size>::read(DataType* outData, int inSize)
+DataType RingBuffer<DataType, Size>::read()
 {
-    for (int i = 0; i < inSize; ++i)
+    const Index readIndex = mReadIndex;
+    if (readIndex == mWriteIndex)
     {
-        outData[i] = read();
+        return DataType();
     }
+
+    // The data must be read after the write index it was published with,
+    // and before the slot is handed back to the producer.
+    MIDI_MEMORY_BARRIER();
+    const DataType data = mData[readIndex & sMask];
+    MIDI_MEMORY_BARRIER();
+    mReadIndex = readIndex + 1;
+    return data;
+}
+
+/*! \brief Take up to inSize of the oldest elements out.
+ \return The number of elements read.
+ */
+template<typename DataType, int Size>
+int RingBuffer<DataType, Size>::read(DataType* outData, int inSize)
+{
+    const Index readIndex   = mReadIndex;
+    const int available     = int(Index(mWriteIndex - readIndex));
+    const int count         = inSize < available ? inSize : available;
+    const int offset        = readIndex & sMask;
+    const int first         = count < Size - offset ? count : Size - offset;
+
+    MIDI_MEMORY_BARRIER();
+    memcpy(static_cast<void*>(outData), mData + offset, first * sizeof(DataType));
+    memcpy(static_cast<void*>(outData + first), mData, (count - first) * sizeof(DataType));
+    MIDI_MEMORY_BARRIER();
+    mReadIndex = readIndex + count;
+    return count;
+}
+
+/*! \brief Get the contiguous run of oldest elements.
+ \param outSize Number of elements readable from the span, 0 when empty.
+ @see commitRead to release the elements once handled.
+ */
+template<typename DataType, int Size>
+const DataType* RingBuffer<DataType, Size>::getReadSpan(int& outSize) const
+{
+    const Index readIndex   = mReadIndex;
+    const int available     = int(Index(mWriteIndex - readIndex));
+    const int offset        = readIndex & sMask;
+
+    outSize = available < Size - offset ? available : Size - offset;
+    MIDI_MEMORY_BARRIER();
+    return mData + offset;
+}
+
+/*! \brief Release inSize elements read from the span from getReadSpan. */
+template<typename DataType, int Size>
+void RingBuffer<DataType, Size>::commitRead(int inSize)
+{
+    MIDI_MEMORY_BARRIER();
+    mReadIndex = mReadIndex + inSize;
+}
+
+/*! \brief Drop all elements, from the consumer side. */
+template<typename DataType, int Size>
+void RingBuffer<DataType, Size>::clear()
+{
+    mReadIndex = mWriteIndex;
 }
 
 END_MIDI_NAMESPACE
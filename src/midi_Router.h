@@ -0,0 +1,188 @@
+/*!
+ *  @file       midi_Router.h
+ *  Project     Arduino MIDI Library
+ *  @brief      MIDI Library for the Arduino - Router and merger
+ *  @author     Francois Best
+ *  @date       17/10/2026
+ *  @license    MIT - Copyright (c) 2026 Francois Best
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "midi_Defs.h"
+#include "midi_StatusTable.h"
+#include "midi_ThruOutput.h"
+
+BEGIN_MIDI_NAMESPACE
+
+/*! Masks of the routing matrix, see Router::setRoute. */
+struct Route
+{
+    enum Types
+    {
+        NoteOffs            = 1 << 0,
+        NoteOns             = 1 << 1,
+        PolyPressures       = 1 << 2,
+        ControlChanges      = 1 << 3,
+        ProgramChanges      = 1 << 4,
+        ChannelPressures    = 1 << 5,
+        PitchBends          = 1 << 6,
+        SystemExclusives    = 1 << 7,
+        SystemCommons       = 1 << 8,   ///< MTC, Song Position, Song Select, Tune Request
+        RealTimes           = 1 << 9,
+
+        ChannelMessages     = 0x7f,
+        AllTypes            = 0x3ff,
+    };
+
+    enum Channels
+    {
+        NoChannel   = 0,
+        AllChannels = 0xffff,           ///< Bit 0 is channel 1.
+    };
+
+    /*! Bit of a message type in the Types mask. */
+    static inline unsigned getTypeMask(MidiType inType)
+    {
+        if (StatusTable::isChannelMessage(inType))
+            return 1u << ((inType >> 4) - 8);
+        if (inType == SystemExclusive)
+            return SystemExclusives;
+        return StatusTable::isRealTime(inType) ? RealTimes : SystemCommons;
+    }
+};
+
+// -----------------------------------------------------------------------------
+
+/*! \brief Routes and merges the messages of up to MaxInputs MidiInterfaces
+ to up to MaxOutputs ThruOutputs.
+
+ Each call to update() handles at most one message per input, starting with
+ a different input every time, so a busy input cannot starve the others.
+ Messages are written whole to the outputs allowed by the routing matrix, so
+ SysEx messages are never interleaved with other messages. SysEx received in
+ chunks holds the outputs it goes to until its last chunk.
+
+ Real Time messages are forwarded through a Thru output attached to each
+ input, as soon as the input parses them: enable
+ Settings::UseRealTimeFastPath on the inputs to send them ahead of the
+ messages waiting in their queue. Enabling Settings::MessageQueueSize on the
+ inputs gives every input its own queue, so that messages are not lost
+ while the router serves the other inputs. Without it, an input held by a
+ SysEx from another one keeps a single message, and its port buffer fills up
+ behind it until the SysEx ends (Real Time messages still go through, up to
+ that message).
+
+ Inputs are read on all channels, their own Thru is turned off: call their
+ begin() method before adding them. The filter mode of the outputs is not
+ used, the routing matrix replaces it.
+ \code{.cpp}
+ midi::Router<MidiInterfaceType, 2, 2> router;
+ router.addInput(midiA);           // Input 0
+ router.addInput(midiB);           // Input 1
+ router.addOutput(outA);           // Output 0
+ router.addOutput(outB);           // Output 1
+ router.setRoute(0, 1);            // Everything from A to B
+ router.setRoute(1, 0, 0x0001, midi::Route::ChannelMessages); // Channel 1 from B to A
+ ...
+ router.update();
+ \endcode
+ */
+template<class Interface, unsigned MaxInputs, unsigned MaxOutputs>
+class Router
+{
+private:
+    // Inputs are numbered from 1 in mSysExOwners, counts are stored on a byte.
+    typedef char InputsMustBeBetween1And254[(MaxInputs > 0 && MaxInputs < 255) ? 1 : -1];
+    typedef char OutputsMustBeBetween1And255[(MaxOutputs > 0 && MaxOutputs < 256) ? 1 : -1];
+
+public:
+    inline Router();
+
+public:
+    bool addInput(Interface& inInput);
+    bool addOutput(ThruOutput& inOutput);
+    inline unsigned getInputCount() const;
+    inline unsigned getOutputCount() const;
+
+public:
+    inline void setRoute(unsigned inInput,
+                         unsigned inOutput,
+                         unsigned inChannels = Route::AllChannels,
+                         unsigned inTypes = Route::AllTypes);
+    inline void clearRoute(unsigned inInput, unsigned inOutput);
+
+public:
+    unsigned update();
+
+private:
+    class RealTimeTap : public ThruOutput
+    {
+    public:
+        inline RealTimeTap()
+            : mRouter(0)
+            , mInput(0)
+        {
+        }
+
+        virtual void write(const byte* inData, unsigned inSize)
+        {
+            if (inSize == 1 && StatusTable::isRealTime(inData[0]))
+            {
+                mRouter->forward(mInput, inData, inSize, MidiType(inData[0]), 0);
+            }
+        }
+
+        Router* mRouter;
+        byte mInput;
+    };
+
+    struct Masks
+    {
+        unsigned mChannels;
+        unsigned mTypes;
+    };
+
+    void forward(unsigned inInput,
+                 const byte* inData,
+                 unsigned inSize,
+                 MidiType inType,
+                 Channel inChannel);
+    inline bool isRouted(unsigned inInput,
+                         unsigned inOutput,
+                         MidiType inType,
+                         Channel inChannel) const;
+    inline bool isHeldByOtherInput(unsigned inInput) const;
+
+private:
+    Interface*  mInputs[MaxInputs];
+    RealTimeTap mTaps[MaxInputs];
+    ThruOutput* mOutputs[MaxOutputs];
+    Masks       mRoutes[MaxInputs][MaxOutputs];
+    byte        mSysExOwners[MaxOutputs];   ///< Input + 1 holding the output, or 0.
+    byte        mInputCount;
+    byte        mOutputCount;
+    byte        mNextInput;
+};
+
+END_MIDI_NAMESPACE
+
+#include "midi_Router.hpp"
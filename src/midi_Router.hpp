@@ -0,0 +1,265 @@
+/*!
+ *  @file       midi_Router.hpp
+ *  Project     Arduino MIDI Library
+ *  @brief      MIDI Library for the Arduino - Router and merger
+ *  @author     Francois Best
+ *  @date       17/10/2026
+ *  @license    MIT - Copyright (c) 2026 Francois Best
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+BEGIN_MIDI_NAMESPACE
+
+template<class Interface, unsigned MaxInputs, unsigned MaxOutputs>
+inline Router<Interface, MaxInputs, MaxOutputs>::Router()
+    : mInputCount(0)
+    , mOutputCount(0)
+    , mNextInput(0)
+{
+    for (unsigned i = 0; i < MaxInputs; ++i)
+    {
+        mInputs[i] = 0;
+        for (unsigned o = 0; o < MaxOutputs; ++o)
+        {
+            mRoutes[i][o].mChannels = Route::NoChannel;
+            mRoutes[i][o].mTypes    = 0;
+        }
+    }
+    for (unsigned o = 0; o < MaxOutputs; ++o)
+    {
+        mOutputs[o] = 0;
+        mSysExOwners[o] = 0;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+/*! \brief Add an input, its index is the number of inputs added before it.
+
+ The input is read on all channels and its Thru is turned off, Real Time
+ messages are routed through an additional Thru output.
+ \return false when MaxInputs inputs were already added.
+ */
+template<class Interface, unsigned MaxInputs, unsigned MaxOutputs>
+bool Router<Interface, MaxInputs, MaxOutputs>::addInput(Interface& inInput)
+{
+    if (mInputCount >= MaxInputs)
+        return false;
+
+    RealTimeTap& tap = mTaps[mInputCount];
+    tap.mRouter = this;
+    tap.mInput  = mInputCount;
+
+    inInput.turnThruOff();
+    inInput.addThruOutput(tap);
+    mInputs[mInputCount++] = &inInput;
+    return true;
+}
+
+/*! \brief Add an output, its index is the number of outputs added before it.
+ \return false when MaxOutputs outputs were already added.
+ */
+template<class Interface, unsigned MaxInputs, unsigned MaxOutputs>
+bool Router<Interface, MaxInputs, MaxOutputs>::addOutput(ThruOutput& inOutput)
+{
+    if (mOutputCount >= MaxOutputs)
+        return false;
+
+    mOutputs[mOutputCount++] = &inOutput;
+    return true;
+}
+
+template<class Interface, unsigned MaxInputs, unsigned MaxOutputs>
+inline unsigned Router<Interface, MaxInputs, MaxOutputs>::getInputCount() const
+{
+    return mInputCount;
+}
+
+template<class Interface, unsigned MaxInputs, unsigned MaxOutputs>
+inline unsigned Router<Interface, MaxInputs, MaxOutputs>::getOutputCount() const
+{
+    return mOutputCount;
+}
+
+// -----------------------------------------------------------------------------
+
+/*! \brief Send messages from an input to an output.
+ \param inInput     Index of the input.
+ \param inOutput    Index of the output.
+ \param inChannels  Channels of the channel messages to send, bit 0 is channel 1.
+ \param inTypes     Types of messages to send, see Route::Types.
+ Replaces the previous route between the same input and output.
+ */
+template<class Interface, unsigned MaxInputs, unsigned MaxOutputs>
+inline void Router<Interface, MaxInputs, MaxOutputs>::setRoute(unsigned inInput,
+                                                               unsigned inOutput,
+                                                               unsigned inChannels,
+                                                               unsigned inTypes)
+{
+    if (inInput < MaxInputs && inOutput < MaxOutputs)
+    {
+        mRoutes[inInput][inOutput].mChannels = inChannels;
+        mRoutes[inInput][inOutput].mTypes    = inTypes;
+    }
+}
+
+template<class Interface, unsigned MaxInputs, unsigned MaxOutputs>
+inline void Router<Interface, MaxInputs, MaxOutputs>::clearRoute(unsigned inInput,
+                                                                 unsigned inOutput)
+{
+    setRoute(inInput, inOutput, Route::NoChannel, 0);
+}
+
+// -----------------------------------------------------------------------------
+
+/*! \brief Route at most one message from each input.
+
+ Call this from loop(). The input served first changes on every call.
+ An input sending a SysEx in chunks holds the outputs it goes to until its
+ last chunk: meanwhile, the other inputs routed to these outputs only forward
+ their Real Time messages.
+ \return The number of messages routed.
+ */
+template<class Interface, unsigned MaxInputs, unsigned MaxOutputs>
+unsigned Router<Interface, MaxInputs, MaxOutputs>::update()
+{
+    unsigned count = 0;
+
+    for (unsigned i = 0; i < mInputCount; ++i)
+    {
+        unsigned input = mNextInput + i;
+        if (input >= mInputCount)
+        {
+            input -= mInputCount;
+        }
+        Interface& midi = *mInputs[input];
+
+        if (isHeldByOtherInput(input))
+        {
+            // Decode only, Real Time messages still go through the tap.
+            // Other messages wait in the input (see readMessages).
+            midi.readMessages(0, MIDI_CHANNEL_OMNI);
+            continue;
+        }
+
+        if (midi.readMessages(1, MIDI_CHANNEL_OMNI) == 0)
+            continue;
+
+        const MidiType type = midi.getType();
+        if (StatusTable::isRealTime(type))
+            continue; // Already forwarded by the tap
+
+        byte buffer[3];
+        const byte* data = buffer;
+        unsigned size = 0;
+        Channel channel = 0;
+
+        if (type == SystemExclusive)
+        {
+            data = midi.getSysExArray();
+            size = midi.getSysExArrayLength();
+        }
+        else
+        {
+            buffer[0] = type;
+            if (StatusTable::isChannelMessage(type))
+            {
+                channel = midi.getChannel();
+                buffer[0] |= (channel - 1) & 0x0f;
+            }
+            buffer[1] = midi.getData1();
+            buffer[2] = midi.getData2();
+            size = StatusTable::getLength(buffer[0]);
+        }
+
+        forward(input, data, size, type, channel);
+        count++;
+    }
+
+    if (mInputCount > 0)
+    {
+        mNextInput = byte(mNextInput + 1 < mInputCount ? mNextInput + 1 : 0);
+    }
+    return count;
+}
+
+// -----------------------------------------------------------------------------
+
+// Private method: write an encoded message to the outputs routed from an input.
+template<class Interface, unsigned MaxInputs, unsigned MaxOutputs>
+void Router<Interface, MaxInputs, MaxOutputs>::forward(unsigned inInput,
+                                                       const byte* inData,
+                                                       unsigned inSize,
+                                                       MidiType inType,
+                                                       Channel inChannel)
+{
+    const byte owner = byte(inInput + 1);
+
+    for (unsigned o = 0; o < mOutputCount; ++o)
+    {
+        if (!isRouted(inInput, o, inType, inChannel))
+            continue;
+
+        mOutputs[o]->write(inData, inSize);
+
+        if (inType == SystemExclusive)
+        {
+            // Chunks that do not end with EOX are followed by other chunks.
+            const bool last = inSize > 0 && inData[inSize - 1] == 0xf7;
+            mSysExOwners[o] = last ? 0 : owner;
+        }
+    }
+}
+
+// Private method: does the routing matrix let a message through?
+template<class Interface, unsigned MaxInputs, unsigned MaxOutputs>
+inline bool Router<Interface, MaxInputs, MaxOutputs>::isRouted(unsigned inInput,
+                                                               unsigned inOutput,
+                                                               MidiType inType,
+                                                               Channel inChannel) const
+{
+    const Masks& route = mRoutes[inInput][inOutput];
+
+    if (!(route.mTypes & Route::getTypeMask(inType)))
+        return false;
+
+    return inChannel == 0 || (route.mChannels & (1u << (inChannel - 1)));
+}
+
+// Private method: is an output of this input held by a SysEx from another one?
+template<class Interface, unsigned MaxInputs, unsigned MaxOutputs>
+inline bool Router<Interface, MaxInputs, MaxOutputs>::isHeldByOtherInput(unsigned inInput) const
+{
+    const byte owner = byte(inInput + 1);
+
+    for (unsigned o = 0; o < mOutputCount; ++o)
+    {
+        if (mSysExOwners[o] != 0 && mSysExOwners[o] != owner &&
+            mRoutes[inInput][o].mTypes != 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+END_MIDI_NAMESPACE
@@ -0,0 +1,138 @@
+/*!
+ *  @file       midi_Scheduler.h
+ *  Project     Arduino MIDI Library
+ *  @brief      MIDI Library for the Arduino - Timestamped output queue
+ *  @author     Francois Best
+ *  @date       17/10/2026
+ *  @license    MIT - Copyright (c) 2026 Francois Best
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "midi_Defs.h"
+#include "midi_Message.h"
+#include "midi_StatusTable.h"
+
+BEGIN_MIDI_NAMESPACE
+
+/*! \brief Min-heap of messages keyed by due time, see Scheduler.
+
+ Messages due at the same time come out in the order they were pushed.
+ Times are compared with unsigned subtraction, so the clock can wrap around
+ as long as messages are not scheduled more than half its range ahead.
+ */
+template<unsigned Capacity>
+class TimedQueue
+{
+private:
+    typedef char CapacityMustNotBeNull[Capacity > 0 ? 1 : -1];
+
+public:
+    inline TimedQueue();
+
+public:
+    inline unsigned getLength() const   { return mLength; }
+    inline bool isEmpty() const         { return mLength == 0; }
+    inline bool isFull() const          { return mLength >= Capacity; }
+    inline void clear()                 { mLength = 0; }
+
+    inline unsigned long getTopTime() const;
+    inline const ShortMessage& getTop() const;
+
+    bool push(unsigned long inTime, const ShortMessage& inMessage);
+    void pop();
+
+private:
+    struct Entry
+    {
+        unsigned long mTime;
+        unsigned mOrder;
+        ShortMessage mMessage;
+    };
+
+    static inline bool isBefore(const Entry& inA, const Entry& inB);
+
+private:
+    Entry mEntries[Capacity];
+    unsigned mLength;
+    unsigned mOrder;
+};
+
+// -----------------------------------------------------------------------------
+
+/*! \brief Sends messages at given times through a MidiInterface.
+
+ Messages are stored with their due time, and sent by service() once due,
+ without busy-waiting: call it from loop(), or from a timer interrupt.
+ Real Time messages have their own lane, emptied first, so that a burst
+ of notes due at the same time does not delay the clock.
+
+ Times come from the Platform of the interface (microseconds with the
+ DefaultPlatform), so that tests can use a fake clock. SysEx messages
+ cannot be scheduled.
+ \code{.cpp}
+ midi::Scheduler<MidiInterfaceType, 32> scheduler(MIDI);
+ const unsigned long now = micros();
+ scheduler.schedule(now,          midi::NoteOn,  60, 100, 1);
+ scheduler.schedule(now + 250000, midi::NoteOff, 60, 0,   1);
+ ...
+ scheduler.service();
+ \endcode
+ */
+template<class Interface, unsigned Capacity, unsigned RealTimeCapacity = 8>
+class Scheduler
+{
+public:
+    typedef typename Interface::Platform Platform;
+
+public:
+    inline explicit Scheduler(Interface& inInterface);
+
+public:
+    bool schedule(unsigned long inTime,
+                  MidiType inType,
+                  DataByte inData1,
+                  DataByte inData2,
+                  Channel inChannel);
+    inline bool scheduleRealTime(unsigned long inTime, MidiType inType);
+
+public:
+    inline unsigned service();
+    unsigned service(unsigned long inNow);
+
+public:
+    inline unsigned getLength() const;
+    inline bool getNextTime(unsigned long& outTime) const;
+    inline void clear();
+
+private:
+    void send(const ShortMessage& inMessage);
+    static inline bool isDue(unsigned long inTime, unsigned long inNow);
+
+private:
+    Interface& mInterface;
+    TimedQueue<Capacity> mMessages;
+    TimedQueue<RealTimeCapacity> mRealTime;
+};
+
+END_MIDI_NAMESPACE
+
+#include "midi_Scheduler.hpp"
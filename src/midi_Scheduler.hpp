@@ -0,0 +1,303 @@
+/*!
+ *  @file       midi_Scheduler.hpp
+ *  Project     Arduino MIDI Library
+ *  @brief      MIDI Library for the Arduino - Timestamped output queue
+ *  @author     Francois Best
+ *  @date       17/10/2026
+ *  @license    MIT - Copyright (c) 2026 Francois Best
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+BEGIN_MIDI_NAMESPACE
+
+template<unsigned Capacity>
+inline TimedQueue<Capacity>::TimedQueue()
+    : mLength(0)
+    , mOrder(0)
+{
+}
+
+template<unsigned Capacity>
+inline unsigned long TimedQueue<Capacity>::getTopTime() const
+{
+    return mEntries[0].mTime;
+}
+
+template<unsigned Capacity>
+inline const ShortMessage& TimedQueue<Capacity>::getTop() const
+{
+    return mEntries[0].mMessage;
+}
+
+/*! \brief Insert a message, in O(log n).
+ \return false when the queue is full.
+ */
+template<unsigned Capacity>
+bool TimedQueue<Capacity>::push(unsigned long inTime, const ShortMessage& inMessage)
+{
+    if (isFull())
+        return false;
+
+    Entry entry;
+    entry.mTime    = inTime;
+    entry.mOrder   = mOrder++;
+    entry.mMessage = inMessage;
+
+    // Sift up
+    unsigned index = mLength++;
+    while (index > 0)
+    {
+        const unsigned parent = (index - 1) / 2;
+        if (!isBefore(entry, mEntries[parent]))
+            break;
+
+        mEntries[index] = mEntries[parent];
+        index = parent;
+    }
+    mEntries[index] = entry;
+    return true;
+}
+
+/*! \brief Remove the earliest message, in O(log n). */
+template<unsigned Capacity>
+void TimedQueue<Capacity>::pop()
+{
+    if (isEmpty())
+        return;
+
+    // Sift down the last entry from the root
+    const Entry& last = mEntries[--mLength];
+    unsigned index = 0;
+    while (true)
+    {
+        unsigned child = 2 * index + 1;
+        if (child >= mLength)
+            break;
+
+        if (child + 1 < mLength && isBefore(mEntries[child + 1], mEntries[child]))
+        {
+            child++;
+        }
+        if (!isBefore(mEntries[child], last))
+            break;
+
+        mEntries[index] = mEntries[child];
+        index = child;
+    }
+    mEntries[index] = last;
+}
+
+// Private method: order of the entries, by time then by insertion order.
+template<unsigned Capacity>
+inline bool TimedQueue<Capacity>::isBefore(const Entry& inA, const Entry& inB)
+{
+    const long delta = long(inA.mTime - inB.mTime);
+    if (delta != 0)
+    {
+        return delta < 0;
+    }
+    return int(inA.mOrder - inB.mOrder) < 0;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class Interface, unsigned Capacity, unsigned RealTimeCapacity>
+inline Scheduler<Interface, Capacity, RealTimeCapacity>::Scheduler(Interface& inInterface)
+    : mInterface(inInterface)
+{
+}
+
+// -----------------------------------------------------------------------------
+
+/*! \brief Schedule a message.
+ \param inTime    When to send the message, in Platform::now() units.
+ \param inType    The message type, Real Time messages go to their own lane.
+ \param inData1   The first data byte.
+ \param inData2   The second data byte (0 if unused).
+ \param inChannel The channel for channel messages (1 to 16).
+ \return false when the message is invalid (or a SysEx), or its lane is full.
+ */
+template<class Interface, unsigned Capacity, unsigned RealTimeCapacity>
+bool Scheduler<Interface, Capacity, RealTimeCapacity>::schedule(unsigned long inTime,
+                                                                MidiType inType,
+                                                                DataByte inData1,
+                                                                DataByte inData2,
+                                                                Channel inChannel)
+{
+    if (!StatusTable::isDefined(inType) || inType == SystemExclusive)
+        return false;
+
+    ShortMessage message;
+    message.status = inType;
+    message.data1  = inData1 & 0x7f;
+    message.data2  = inData2 & 0x7f;
+    message.flags  = ShortMessage::Valid;
+
+    if (StatusTable::isChannelMessage(inType))
+    {
+        if (inChannel == MIDI_CHANNEL_OMNI || inChannel >= MIDI_CHANNEL_OFF)
+            return false;
+
+        message.status |= (inChannel - 1) & 0x0f;
+    }
+    else if (StatusTable::isRealTime(inType))
+    {
+        return mRealTime.push(inTime, message);
+    }
+    return mMessages.push(inTime, message);
+}
+
+/*! \brief Schedule a Real Time message (Clock, Start, Stop...). */
+template<class Interface, unsigned Capacity, unsigned RealTimeCapacity>
+inline bool Scheduler<Interface, Capacity, RealTimeCapacity>::scheduleRealTime(unsigned long inTime,
+                                                                               MidiType inType)
+{
+    return StatusTable::isRealTime(inType) && schedule(inTime, inType, 0, 0, 0);
+}
+
+// -----------------------------------------------------------------------------
+
+/*! \brief Send the messages due at Platform::now().
+ @see service(unsigned long)
+ */
+template<class Interface, unsigned Capacity, unsigned RealTimeCapacity>
+inline unsigned Scheduler<Interface, Capacity, RealTimeCapacity>::service()
+{
+    return service(Platform::now());
+}
+
+/*! \brief Send the messages due at a given time.
+
+ Real Time messages are sent first, then the other messages, in the order of
+ their due times. The output of the interface is flushed afterwards (see
+ DefaultSettings::OutputBufferSize).
+ \param inNow The current time, in Platform::now() units.
+ \return The number of messages sent.
+ */
+template<class Interface, unsigned Capacity, unsigned RealTimeCapacity>
+unsigned Scheduler<Interface, Capacity, RealTimeCapacity>::service(unsigned long inNow)
+{
+    unsigned count = 0;
+
+    while (!mRealTime.isEmpty() && isDue(mRealTime.getTopTime(), inNow))
+    {
+        send(mRealTime.getTop());
+        mRealTime.pop();
+        count++;
+    }
+    while (!mMessages.isEmpty() && isDue(mMessages.getTopTime(), inNow))
+    {
+        send(mMessages.getTop());
+        mMessages.pop();
+        count++;
+    }
+
+    if (count > 0)
+    {
+        mInterface.flush();
+    }
+    return count;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class Interface, unsigned Capacity, unsigned RealTimeCapacity>
+inline unsigned Scheduler<Interface, Capacity, RealTimeCapacity>::getLength() const
+{
+    return mMessages.getLength() + mRealTime.getLength();
+}
+
+/*! \brief Due time of the next message, to sleep until then.
+ \return false when no message is scheduled.
+ */
+template<class Interface, unsigned Capacity, unsigned RealTimeCapacity>
+inline bool Scheduler<Interface, Capacity, RealTimeCapacity>::getNextTime(unsigned long& outTime) const
+{
+    if (mMessages.isEmpty() && mRealTime.isEmpty())
+        return false;
+
+    if (mMessages.isEmpty())
+    {
+        outTime = mRealTime.getTopTime();
+    }
+    else if (mRealTime.isEmpty() || isDue(mMessages.getTopTime(), mRealTime.getTopTime()))
+    {
+        outTime = mMessages.getTopTime();
+    }
+    else
+    {
+        outTime = mRealTime.getTopTime();
+    }
+    return true;
+}
+
+/*! \brief Drop all scheduled messages. */
+template<class Interface, unsigned Capacity, unsigned RealTimeCapacity>
+inline void Scheduler<Interface, Capacity, RealTimeCapacity>::clear()
+{
+    mMessages.clear();
+    mRealTime.clear();
+}
+
+// -----------------------------------------------------------------------------
+
+// Private method: send a message through the interface.
+template<class Interface, unsigned Capacity, unsigned RealTimeCapacity>
+void Scheduler<Interface, Capacity, RealTimeCapacity>::send(const ShortMessage& inMessage)
+{
+    const MidiType type = inMessage.getType();
+    switch (type)
+    {
+        case TimeCodeQuarterFrame:
+            mInterface.sendTimeCodeQuarterFrame(inMessage.data1);
+            break;
+        case SongPosition:
+            mInterface.sendSongPosition(unsigned(inMessage.data2) << 7 | inMessage.data1);
+            break;
+        case SongSelect:
+            mInterface.sendSongSelect(inMessage.data1);
+            break;
+        case TuneRequest:
+            mInterface.sendTuneRequest();
+            break;
+        default:
+            if (StatusTable::isRealTime(type))
+            {
+                mInterface.sendRealTime(type);
+            }
+            else
+            {
+                mInterface.send(type, inMessage.data1, inMessage.data2, inMessage.getChannel());
+            }
+            break;
+    }
+}
+
+// Private method: has a due time been reached?
+template<class Interface, unsigned Capacity, unsigned RealTimeCapacity>
+inline bool Scheduler<Interface, Capacity, RealTimeCapacity>::isDue(unsigned long inTime,
+                                                                    unsigned long inNow)
+{
+    return long(inNow - inTime) >= 0;
+}
+
+END_MIDI_NAMESPACE
@@ -51,9 +51,18 @@ struct DefaultSettings
     /*! Running status enables short messages when sending multiple values
     of the same type and channel.\n
     Warning: does not work with some hardware, enable with caution.
+    Do not enable it on an interface whose port is also written by a
+    ThruOutput of another interface (merger), see ThruOutput.
     */
     static const bool UseRunningStatus = false;
 
+    /*! With Running Status, send NoteOff messages as NoteOn with 0 velocity,
+    so that notes played and released on a channel share the same status.\n
+    Only NoteOff messages without release velocity (0, or 64 as recommended
+    by the MIDI specification) are converted.
+    */
+    static const bool SendNoteOffAsNullVelocityNoteOn = false;
+
     /*! NoteOn with 0 velocity should be handled as NoteOf.\n
     Set to true  to get NoteOff events when receiving null-velocity NoteOn messages.\n
     Set to false to get NoteOn  events when receiving null-velocity NoteOn messages.
@@ -62,10 +71,28 @@ struct DefaultSettings
 
     /*! Setting this to true will make MIDI.read parse only one byte of data for each
     call when data is available. This can speed up your application if receiving
-    a lot of traffic, but might induce MIDI Thru and treatment latency.
+    a lot of traffic, but might induce MIDI Thru and treatment latency.\n
+    When false, MIDI.read loops over the available bytes until a message is
+    complete: stack usage does not depend on the message length, and a call
+    never consumes more bytes than were available when it started.
     */
     static const bool Use1ByteParsing = true;
 
+    /*! Handle Real Time messages (Clock, Start, Stop...) as soon as their byte
+    is read from the port, ahead of any pending or queued message: their
+    callback is called and they are sent to Thru (when enabled) right away.\n
+    They are not counted as messages and do not show up in getType().
+    */
+    static const bool UseRealTimeFastPath = false;
+
+    /*! Forward each received byte to Thru as soon as it is parsed, like a
+    hardware thru, instead of sending the whole message once received.\n
+    The filter is applied when the status byte arrives, using the input
+    channel, and Running Status is kept as received. A SysEx message that
+    overflows SysExMaxSize is closed with an EOX on the output.
+    */
+    static const bool UseCutThroughThru = false;
+
     /*! Override the default MIDI baudrate to transmit over USB serial, to
     a decoding program such as Hairless MIDI (set baudrate to 115200)\n
     http://projectgus.github.io/hairless-midiserial/
@@ -73,9 +100,52 @@ struct DefaultSettings
     static const long BaudRate = 31250;
 
     /*! Maximum size of SysEx receivable. Decrease to save RAM if you don't expect
-    to receive SysEx, or adjust accordingly.
+    to receive SysEx, or adjust accordingly.\n
+    When a handler is set with setHandleSystemExclusiveChunk, SysEx messages of
+    any length are received in chunks of this size instead (2 bytes minimum).
     */
     static const unsigned SysExMaxSize = 128;
+
+    /*! Number of decoded messages that can wait to be handled (0 to disable).\n
+    When enabled, read() decodes every byte received so far into the queue,
+    then hands over the oldest message, so a message is never overwritten by
+    the next one before it is handled.\n
+    RAM cost: the buffers round up to a power of two. MessageQueueSize
+    rounded up gives the slots (3 takes 4), of 4 bytes each, plus an unsigned
+    long with UseReceiveTimestamps. SysEx payloads share a buffer of twice
+    SysExMaxSize rounded up (256 bytes for 128, 512 for 130). The queue also
+    holds the message being decoded: another SysExMaxSize bytes plus its
+    header.
+    */
+    static const unsigned MessageQueueSize = 0;
+
+    /*! Number of output bytes collected before they are written to the port
+    (0 to disable, bytes are then written one at a time).\n
+    When enabled, the port must have a write(const byte*, n) method, like the
+    Arduino Print class. Buffered bytes are written by flush(), when the
+    buffer is full, and at the end of each read call so that Thru is not
+    held back.
+    */
+    static const unsigned OutputBufferSize = 0;
+
+    /*! Record when each received message started, from Platform::now(), in
+    the timestamp field of Message (see MidiInterface::getTimestamp).\n
+    The time is taken when the first byte of the message is parsed: read
+    from the port by read(), or pushed by feed(). Interleaved Real Time
+    messages get their own time. Costs 4 bytes per message, and per queued
+    message with MessageQueueSize.
+    */
+    static const bool UseReceiveTimestamps = false;
+
+    /*! Count parsed bytes, messages by type, and input errors: SysEx messages
+    dropped for exceeding SysExMaxSize, invalid status bytes, data bytes
+    without a status, and messages dropped by a full queue. With
+    UseReceiveTimestamps, also keep a histogram of the latency between the
+    first byte of a message and its dispatch.\n
+    See MidiInterface::getStatistics and midi_Statistics.h. Costs about 180
+    bytes of RAM, and nothing when disabled.
+    */
+    static const bool UseStatistics = false;
 };
 
 END_MIDI_NAMESPACE
@@ -0,0 +1,272 @@
+/*!
+ *  @file       midi_SmfPlayer.h
+ *  Project     Arduino MIDI Library
+ *  @brief      MIDI Library for the Arduino - Standard MIDI File player
+ *  @author     Francois Best
+ *  @date       17/10/2026
+ *  @license    MIT - Copyright (c) 2026 Francois Best
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#include "midi_Defs.h"
+#include "midi_StatusTable.h"
+#include <string.h>
+
+#if !ARDUINO
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+BEGIN_MIDI_NAMESPACE
+
+/*! \brief Standard MIDI File already in memory, see SmfPlayer.
+
+ Use it for a file in RAM or mapped by the system (see SmfMappedFile).
+ Any other storage can be played with a class that has the same read method,
+ eg: for the Arduino SD library:
+ \code{.cpp}
+ struct SdSource
+ {
+     File& mFile;
+     unsigned read(unsigned long inOffset, byte* outData, unsigned inSize)
+     {
+         return mFile.seek(inOffset) ? mFile.read(outData, inSize) : 0;
+     }
+ };
+ \endcode
+ */
+class SmfMemorySource
+{
+public:
+    inline SmfMemorySource(const byte* inData = 0, unsigned long inSize = 0)
+        : mData(inData)
+        , mSize(inSize)
+    {
+    }
+
+public:
+    /*! Copy up to inSize bytes from inOffset, return the number copied. */
+    inline unsigned read(unsigned long inOffset, byte* outData, unsigned inSize)
+    {
+        if (inOffset >= mSize)
+            return 0;
+
+        if (mSize - inOffset < inSize)
+        {
+            inSize = unsigned(mSize - inOffset);
+        }
+        memcpy(outData, mData + inOffset, inSize);
+        return inSize;
+    }
+
+protected:
+    const byte* mData;
+    unsigned long mSize;
+};
+
+#if !ARDUINO
+
+/*! \brief Standard MIDI File mapped in memory, so that the system pages in
+ the parts being played instead of loading the whole file.
+ */
+class SmfMappedFile : public SmfMemorySource
+{
+public:
+    inline SmfMappedFile()
+    {
+    }
+
+    inline ~SmfMappedFile()
+    {
+        close();
+    }
+
+public:
+    inline bool open(const char* inPath)
+    {
+        close();
+        const int fd = ::open(inPath, O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        struct stat status;
+        void* data = MAP_FAILED;
+        if (fstat(fd, &status) == 0 && status.st_size > 0)
+        {
+            data = mmap(0, size_t(status.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        ::close(fd); // The mapping keeps the file open.
+
+        if (data == MAP_FAILED)
+            return false;
+
+        mData = static_cast<const byte*>(data);
+        mSize = (unsigned long)status.st_size;
+        return true;
+    }
+
+    inline void close()
+    {
+        if (mData != 0)
+        {
+            munmap(const_cast<byte*>(mData), size_t(mSize));
+            mData = 0;
+            mSize = 0;
+        }
+    }
+
+private:
+    SmfMappedFile(const SmfMappedFile&);
+    SmfMappedFile& operator=(const SmfMappedFile&);
+};
+
+#endif
+
+// -----------------------------------------------------------------------------
+
+/*! \brief Incremental reader of a track chunk, see SmfPlayer.
+
+ Holds the next event of the track, decoded from a read-ahead buffer of
+ BufferSize bytes refilled from the source as needed.
+ */
+template<class Source, unsigned BufferSize>
+class SmfTrack
+{
+public:
+    inline SmfTrack();
+
+public:
+    inline void open(Source* inSource, unsigned long inOffset, unsigned long inLength);
+    bool readEvent();
+
+public:
+    inline bool readByte(byte& outData);
+    bool readVariableLength(unsigned long& outValue);
+    void skip(unsigned long inSize);
+
+public:
+    unsigned long mTick;    ///< Absolute time of the event, in ticks.
+    byte mStatus;           ///< Status byte, 0xf0 or 0xf7 for SysEx, 0xff for meta events.
+    byte mData[2];          ///< Data of a channel message, type of a meta event.
+    unsigned long mLength;  ///< Length of the SysEx or meta event data, left to read.
+
+private:
+    inline bool fill();
+
+private:
+    Source* mSource;
+    unsigned long mOffset;  ///< File offset of the buffer.
+    unsigned long mEnd;     ///< File offset of the end of the chunk.
+    unsigned mBufferLength;
+    unsigned mBufferIndex;
+    byte mRunningStatus;
+    byte mBuffer[BufferSize];
+};
+
+// -----------------------------------------------------------------------------
+
+/*! \brief Plays a Standard MIDI File (format 0 or 1) through a MidiInterface.
+
+ Tracks are decoded incrementally, each from its own read-ahead buffer of
+ BufferSize bytes, so that files of any size can be played from storage
+ with a few hundred bytes of RAM. Their events are merged in time order
+ with a heap, converted from ticks to microseconds with the tempo map, and
+ sent by service() once due: call it from loop(), like Scheduler::service.
+ SysEx events are sent in chunks of BufferSize bytes.
+ \code{.cpp}
+ midi::SmfMappedFile file;
+ midi::SmfPlayer<MidiInterfaceType, midi::SmfMappedFile> player(MIDI);
+ if (file.open("song.mid") && player.open(file))
+ {
+     player.start();
+     while (player.isPlaying())
+     {
+         player.service();
+     }
+ }
+ \endcode
+ The Platform of the interface must count microseconds (as DefaultPlatform).
+ */
+template<class Interface, class Source, unsigned MaxTracks = 16, unsigned BufferSize = 16>
+class SmfPlayer
+{
+private:
+    typedef char MaxTracksMustBeBetween1And255[MaxTracks > 0 && MaxTracks < 256 ? 1 : -1];
+    typedef char BufferSizeMustNotBeNull[BufferSize > 0 ? 1 : -1];
+
+public:
+    typedef typename Interface::Platform Platform;
+    typedef SmfTrack<Source, BufferSize> Track;
+
+public:
+    inline explicit SmfPlayer(Interface& inInterface);
+
+public:
+    bool open(Source& inSource);
+    inline void start();
+    inline void start(unsigned long inNow);
+    inline void stop();
+    inline bool isPlaying() const;
+
+public:
+    inline unsigned service();
+    unsigned service(unsigned long inNow);
+    inline bool getNextTime(unsigned long& outTime) const;
+
+public:
+    inline unsigned getFormat() const;
+    inline unsigned getTrackCount() const;
+
+private:
+    void send(Track& ioTrack);
+    bool sendSysEx(Track& ioTrack);
+    bool handleMetaEvent(Track& ioTrack);
+    unsigned long getTime(unsigned long inTick, unsigned long& outFraction) const;
+    inline void setTempo(unsigned long inMicrosPerUnit);
+    void siftDown(unsigned inIndex);
+    inline bool isBefore(byte inA, byte inB) const;
+    static inline unsigned long readBigEndian(const byte* inData, unsigned inSize);
+
+private:
+    Interface& mInterface;
+    Track mTracks[MaxTracks];
+    byte mHeap[MaxTracks];      ///< Tracks with events left, next one first.
+    unsigned mHeapLength;
+    unsigned mTrackCount;
+    unsigned mFormat;
+    unsigned mTickDivisor;      ///< Ticks per quarter note, or per second (SMPTE).
+    bool mTempoMapped;          ///< False for SMPTE time division.
+    unsigned long mMicrosPerTick;
+    unsigned long mMicrosRemainder;
+    unsigned long mTick;        ///< Time of the last event sent, in ticks,
+    unsigned long mTime;        ///< in microseconds since start,
+    unsigned long mFraction;    ///< and the remainder, in 1/mTickDivisor microseconds.
+    unsigned long mStartTime;
+    bool mPlaying;
+};
+
+END_MIDI_NAMESPACE
+
+#include "midi_SmfPlayer.hpp"
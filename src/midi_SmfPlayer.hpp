@@ -0,0 +1,573 @@
+/*!
+ *  @file       midi_SmfPlayer.hpp
+ *  Project     Arduino MIDI Library
+ *  @brief      MIDI Library for the Arduino - Standard MIDI File player
+ *  @author     Francois Best
+ *  @date       17/10/2026
+ *  @license    MIT - Copyright (c) 2026 Francois Best
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+BEGIN_MIDI_NAMESPACE
+
+template<class Source, unsigned BufferSize>
+inline SmfTrack<Source, BufferSize>::SmfTrack()
+    : mTick(0)
+    , mStatus(0)
+    , mLength(0)
+    , mSource(0)
+    , mOffset(0)
+    , mEnd(0)
+    , mBufferLength(0)
+    , mBufferIndex(0)
+    , mRunningStatus(0)
+{
+    mData[0] = 0;
+    mData[1] = 0;
+}
+
+template<class Source, unsigned BufferSize>
+inline void SmfTrack<Source, BufferSize>::open(Source* inSource,
+                                               unsigned long inOffset,
+                                               unsigned long inLength)
+{
+    mSource         = inSource;
+    mOffset         = inOffset;
+    mEnd            = inOffset + inLength < inOffset ? ~0ul : inOffset + inLength;
+    mBufferLength   = 0;
+    mBufferIndex    = 0;
+    mRunningStatus  = 0;
+    mTick           = 0;
+    mStatus         = 0;
+    mLength         = 0;
+}
+
+/*! \brief Decode the header of the next event: its time, status and, for
+ channel messages, its data. SysEx and meta event data is left to read.
+ \return false at the end of the chunk, or when the track is malformed.
+ */
+template<class Source, unsigned BufferSize>
+bool SmfTrack<Source, BufferSize>::readEvent()
+{
+    unsigned long delta = 0;
+    byte data = 0;
+    if (!readVariableLength(delta) || !readByte(data))
+        return false;
+
+    mTick += delta;
+
+    if (data < 0x80)
+    {
+        // Running Status: only for channel messages.
+        if (mRunningStatus == 0)
+            return false;
+
+        mStatus  = mRunningStatus;
+        mData[0] = data;
+        mData[1] = 0;
+        return StatusTable::getLength(mStatus) == 2 || readByte(mData[1]);
+    }
+
+    mStatus = data;
+    if (data < 0xf0)
+    {
+        mRunningStatus = data;
+        mData[1] = 0;
+        return readByte(mData[0]) &&
+               (StatusTable::getLength(data) == 2 || readByte(mData[1]));
+    }
+
+    // SysEx and meta events cancel Running Status.
+    mRunningStatus = 0;
+    if (data == 0xff)
+    {
+        if (!readByte(mData[0]))
+            return false;
+    }
+    else if (data != 0xf0 && data != 0xf7)
+    {
+        // Not allowed in a file.
+        return false;
+    }
+    return readVariableLength(mLength);
+}
+
+template<class Source, unsigned BufferSize>
+inline bool SmfTrack<Source, BufferSize>::readByte(byte& outData)
+{
+    if (mBufferIndex == mBufferLength && !fill())
+        return false;
+
+    outData = mBuffer[mBufferIndex++];
+    return true;
+}
+
+/*! \brief Read a variable-length quantity (up to 4 bytes). */
+template<class Source, unsigned BufferSize>
+bool SmfTrack<Source, BufferSize>::readVariableLength(unsigned long& outValue)
+{
+    unsigned long value = 0;
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        byte data = 0;
+        if (!readByte(data))
+            return false;
+
+        value = (value << 7) | (data & 0x7f);
+        if (!(data & 0x80))
+        {
+            outValue = value;
+            return true;
+        }
+    }
+    return false;
+}
+
+/*! \brief Skip bytes, without reading them from the source. */
+template<class Source, unsigned BufferSize>
+void SmfTrack<Source, BufferSize>::skip(unsigned long inSize)
+{
+    const unsigned buffered = mBufferLength - mBufferIndex;
+    if (inSize <= buffered)
+    {
+        mBufferIndex += unsigned(inSize);
+        return;
+    }
+
+    const unsigned long position = mOffset + mBufferLength;
+    inSize -= buffered;
+    mOffset = inSize < mEnd - position ? position + inSize : mEnd;
+    mBufferLength = 0;
+    mBufferIndex  = 0;
+}
+
+// Private method: read ahead the next bytes of the chunk.
+template<class Source, unsigned BufferSize>
+inline bool SmfTrack<Source, BufferSize>::fill()
+{
+    mOffset += mBufferLength;
+    mBufferLength = 0;
+    mBufferIndex  = 0;
+
+    if (mOffset >= mEnd)
+        return false;
+
+    const unsigned long remaining = mEnd - mOffset;
+    mBufferLength = mSource->read(mOffset, mBuffer,
+                                  remaining < BufferSize ? unsigned(remaining) : BufferSize);
+    return mBufferLength > 0;
+}
+
+// -----------------------------------------------------------------------------
+
+template<class Interface, class Source, unsigned MaxTracks, unsigned BufferSize>
+inline SmfPlayer<Interface, Source, MaxTracks, BufferSize>::SmfPlayer(Interface& inInterface)
+    : mInterface(inInterface)
+    , mHeapLength(0)
+    , mTrackCount(0)
+    , mFormat(0)
+    , mTickDivisor(1)
+    , mTempoMapped(true)
+    , mMicrosPerTick(0)
+    , mMicrosRemainder(0)
+    , mTick(0)
+    , mTime(0)
+    , mFraction(0)
+    , mStartTime(0)
+    , mPlaying(false)
+{
+}
+
+// -----------------------------------------------------------------------------
+
+/*! \brief Read the header of a file, and get ready to play it from the start.
+
+ Only the header and the first event of each track are read here.
+ \param inSource The file, it must remain valid while playing.
+ \return false when the file is not a format 0 or 1 Standard MIDI File, or
+ has more than MaxTracks tracks.
+ */
+template<class Interface, class Source, unsigned MaxTracks, unsigned BufferSize>
+bool SmfPlayer<Interface, Source, MaxTracks, BufferSize>::open(Source& inSource)
+{
+    mHeapLength = 0;
+    mTrackCount = 0;
+    mTick       = 0;
+    mTime       = 0;
+    mFraction   = 0;
+    mPlaying    = false;
+
+    byte header[14];
+    if (inSource.read(0, header, 14) != 14 || memcmp(header, "MThd", 4) != 0)
+        return false;
+
+    const unsigned long headerLength = readBigEndian(header + 4, 4);
+    const unsigned trackCount = unsigned(readBigEndian(header + 10, 2));
+    const unsigned division   = unsigned(readBigEndian(header + 12, 2));
+    mFormat = unsigned(readBigEndian(header + 8, 2));
+
+    if (headerLength < 6 || mFormat > 1 || trackCount > MaxTracks)
+        return false;
+
+    if (division & 0x8000)
+    {
+        // SMPTE: negative frames per second (29 is 29.97), and ticks per frame.
+        const unsigned framesPerSecond = 256 - (division >> 8);
+        const unsigned ticksPerFrame   = division & 0xff;
+        if (ticksPerFrame == 0)
+            return false;
+
+        mTempoMapped = false;
+        mTickDivisor = (framesPerSecond == 29 ? 30 : framesPerSecond) * ticksPerFrame;
+        setTempo(framesPerSecond == 29 ? 1001000ul : 1000000ul);
+    }
+    else
+    {
+        if (division == 0)
+            return false;
+
+        // Ticks per quarter note, at 120 BPM until told otherwise.
+        mTempoMapped = true;
+        mTickDivisor = division;
+        setTempo(500000ul);
+    }
+
+    // Skip unknown chunks, as the norm requires.
+    unsigned long offset = 8 + headerLength;
+    while (mTrackCount < trackCount)
+    {
+        byte chunk[8];
+        if (inSource.read(offset, chunk, 8) != 8)
+            break;
+
+        const unsigned long length = readBigEndian(chunk + 4, 4);
+        if (memcmp(chunk, "MTrk", 4) == 0)
+        {
+            mTracks[mTrackCount++].open(&inSource, offset + 8, length);
+        }
+        offset += 8 + length;
+    }
+
+    for (unsigned i = 0; i < mTrackCount; ++i)
+    {
+        if (mTracks[i].readEvent())
+        {
+            mHeap[mHeapLength++] = byte(i);
+        }
+    }
+    for (unsigned i = mHeapLength / 2; i > 0; --i)
+    {
+        siftDown(i - 1);
+    }
+    return mTrackCount > 0;
+}
+
+/*! \brief Start playing the opened file now. */
+template<class Interface, class Source, unsigned MaxTracks, unsigned BufferSize>
+inline void SmfPlayer<Interface, Source, MaxTracks, BufferSize>::start()
+{
+    start(Platform::now());
+}
+
+/*! \brief Start playing the opened file at a given time.
+ \param inNow The time of the beginning of the file, in Platform::now() units.
+ */
+template<class Interface, class Source, unsigned MaxTracks, unsigned BufferSize>
+inline void SmfPlayer<Interface, Source, MaxTracks, BufferSize>::start(unsigned long inNow)
+{
+    mStartTime = inNow;
+    mPlaying   = mHeapLength > 0;
+}
+
+/*! \brief Stop sending events. Notes left on are not released, and open()
+ must be called again to play the file from the start.
+ */
+template<class Interface, class Source, unsigned MaxTracks, unsigned BufferSize>
+inline void SmfPlayer<Interface, Source, MaxTracks, BufferSize>::stop()
+{
+    mPlaying = false;
+}
+
+/*! \brief False when stopped, or once all the events of the file are sent. */
+template<class Interface, class Source, unsigned MaxTracks, unsigned BufferSize>
+inline bool SmfPlayer<Interface, Source, MaxTracks, BufferSize>::isPlaying() const
+{
+    return mPlaying;
+}
+
+// -----------------------------------------------------------------------------
+
+/*! \brief Send the events due at Platform::now().
+ @see service(unsigned long)
+ */
+template<class Interface, class Source, unsigned MaxTracks, unsigned BufferSize>
+inline unsigned SmfPlayer<Interface, Source, MaxTracks, BufferSize>::service()
+{
+    return service(Platform::now());
+}
+
+/*! \brief Send the events due at a given time.
+
+ Events are sent in time order, tracks in the order of the file for events
+ at the same time, so that the tempo track comes first. The output of the
+ interface is flushed afterwards (see DefaultSettings::OutputBufferSize).
+ \param inNow The current time, in Platform::now() units.
+ \return The number of messages sent.
+ */
+template<class Interface, class Source, unsigned MaxTracks, unsigned BufferSize>
+unsigned SmfPlayer<Interface, Source, MaxTracks, BufferSize>::service(unsigned long inNow)
+{
+    if (!mPlaying)
+        return 0;
+
+    unsigned count = 0;
+    while (mHeapLength > 0)
+    {
+        Track& track = mTracks[mHeap[0]];
+        unsigned long fraction = 0;
+        const unsigned long time = getTime(track.mTick, fraction);
+        if (long(inNow - (mStartTime + time)) < 0)
+            break;
+
+        mTick     = track.mTick;
+        mTime     = time;
+        mFraction = fraction;
+
+        bool more = true;
+        if (track.mStatus < 0xf0)
+        {
+            send(track);
+            count++;
+        }
+        else if (track.mStatus == 0xff)
+        {
+            more = handleMetaEvent(track);
+        }
+        else
+        {
+            more = sendSysEx(track);
+            count++;
+        }
+
+        if (!more || !track.readEvent())
+        {
+            // End of track.
+            mHeap[0] = mHeap[--mHeapLength];
+        }
+        siftDown(0);
+    }
+
+    if (mHeapLength == 0)
+    {
+        mPlaying = false;
+    }
+    if (count > 0)
+    {
+        mInterface.flush();
+    }
+    return count;
+}
+
+/*! \brief Time of the next event, to sleep until then.
+ \return false when not playing.
+ */
+template<class Interface, class Source, unsigned MaxTracks, unsigned BufferSize>
+inline bool SmfPlayer<Interface, Source, MaxTracks, BufferSize>::getNextTime(unsigned long& outTime) const
+{
+    if (!mPlaying || mHeapLength == 0)
+        return false;
+
+    unsigned long fraction = 0;
+    outTime = mStartTime + getTime(mTracks[mHeap[0]].mTick, fraction);
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+
+/*! \brief 0 for a single track, 1 for simultaneous tracks. */
+template<class Interface, class Source, unsigned MaxTracks, unsigned BufferSize>
+inline unsigned SmfPlayer<Interface, Source, MaxTracks, BufferSize>::getFormat() const
+{
+    return mFormat;
+}
+
+template<class Interface, class Source, unsigned MaxTracks, unsigned BufferSize>
+inline unsigned SmfPlayer<Interface, Source, MaxTracks, BufferSize>::getTrackCount() const
+{
+    return mTrackCount;
+}
+
+// -----------------------------------------------------------------------------
+
+// Private method: send the channel message of a track.
+template<class Interface, class Source, unsigned MaxTracks, unsigned BufferSize>
+void SmfPlayer<Interface, Source, MaxTracks, BufferSize>::send(Track& ioTrack)
+{
+    mInterface.send(MidiType(ioTrack.mStatus & 0xf0),
+                    ioTrack.mData[0],
+                    ioTrack.mData[1],
+                    Channel((ioTrack.mStatus & 0x0f) + 1));
+}
+
+// Private method: send the SysEx event of a track, in chunks.
+// Events starting with 0xf7 (continuations and escapes) are sent as is.
+template<class Interface, class Source, unsigned MaxTracks, unsigned BufferSize>
+bool SmfPlayer<Interface, Source, MaxTracks, BufferSize>::sendSysEx(Track& ioTrack)
+{
+    byte chunk[BufferSize];
+    unsigned size = 0;
+    if (ioTrack.mStatus == 0xf0)
+    {
+        chunk[size++] = 0xf0;
+    }
+
+    while (true)
+    {
+        if (size == BufferSize || (ioTrack.mLength == 0 && size > 0))
+        {
+            mInterface.sendSysEx(size, chunk, true);
+            size = 0;
+        }
+        if (ioTrack.mLength == 0)
+            return true;
+
+        if (!ioTrack.readByte(chunk[size]))
+            return false;
+
+        ioTrack.mLength--;
+        size++;
+    }
+}
+
+// Private method: apply tempo changes, skip other meta events.
+// Returns false at the end of the track.
+template<class Interface, class Source, unsigned MaxTracks, unsigned BufferSize>
+bool SmfPlayer<Interface, Source, MaxTracks, BufferSize>::handleMetaEvent(Track& ioTrack)
+{
+    static const byte EndOfTrack = 0x2f;
+    static const byte SetTempo   = 0x51;
+
+    if (ioTrack.mData[0] == EndOfTrack)
+        return false;
+
+    if (ioTrack.mData[0] == SetTempo && ioTrack.mLength == 3 && mTempoMapped)
+    {
+        byte tempo[3];
+        if (!ioTrack.readByte(tempo[0]) ||
+            !ioTrack.readByte(tempo[1]) ||
+            !ioTrack.readByte(tempo[2]))
+        {
+            return false;
+        }
+        setTempo(readBigEndian(tempo, 3));
+        return true;
+    }
+
+    ioTrack.skip(ioTrack.mLength);
+    return true;
+}
+
+// Private method: time of a tick, from the last event sent.
+// Steps of 16 bits keep the products within 32 bits, the sum can wrap
+// around like Platform::now().
+template<class Interface, class Source, unsigned MaxTracks, unsigned BufferSize>
+unsigned long SmfPlayer<Interface, Source, MaxTracks, BufferSize>::getTime(unsigned long inTick,
+                                                                           unsigned long& outFraction) const
+{
+    unsigned long delta    = inTick - mTick;
+    unsigned long time     = mTime;
+    unsigned long fraction = mFraction;
+
+    while (delta > 0)
+    {
+        const unsigned long step = delta < 0xffff ? delta : 0xffff;
+        time     += step * mMicrosPerTick;
+        fraction += step * mMicrosRemainder;
+        time     += fraction / mTickDivisor;
+        fraction %= mTickDivisor;
+        delta    -= step;
+    }
+    outFraction = fraction;
+    return time;
+}
+
+// Private method: set the duration of a quarter note (or of a second, SMPTE).
+template<class Interface, class Source, unsigned MaxTracks, unsigned BufferSize>
+inline void SmfPlayer<Interface, Source, MaxTracks, BufferSize>::setTempo(unsigned long inMicrosPerUnit)
+{
+    mMicrosPerTick   = inMicrosPerUnit / mTickDivisor;
+    mMicrosRemainder = inMicrosPerUnit % mTickDivisor;
+}
+
+// Private method: restore the heap below a track that moved, in O(log n).
+template<class Interface, class Source, unsigned MaxTracks, unsigned BufferSize>
+void SmfPlayer<Interface, Source, MaxTracks, BufferSize>::siftDown(unsigned inIndex)
+{
+    if (inIndex >= mHeapLength)
+        return;
+
+    const byte root = mHeap[inIndex];
+    unsigned index = inIndex;
+    while (true)
+    {
+        unsigned child = 2 * index + 1;
+        if (child >= mHeapLength)
+            break;
+
+        if (child + 1 < mHeapLength && isBefore(mHeap[child + 1], mHeap[child]))
+        {
+            child++;
+        }
+        if (!isBefore(mHeap[child], root))
+            break;
+
+        mHeap[index] = mHeap[child];
+        index = child;
+    }
+    mHeap[index] = root;
+}
+
+// Private method: order of the tracks, by time of their next event then by
+// their order in the file.
+template<class Interface, class Source, unsigned MaxTracks, unsigned BufferSize>
+inline bool SmfPlayer<Interface, Source, MaxTracks, BufferSize>::isBefore(byte inA, byte inB) const
+{
+    if (mTracks[inA].mTick != mTracks[inB].mTick)
+    {
+        return mTracks[inA].mTick < mTracks[inB].mTick;
+    }
+    return inA < inB;
+}
+
+template<class Interface, class Source, unsigned MaxTracks, unsigned BufferSize>
+inline unsigned long SmfPlayer<Interface, Source, MaxTracks, BufferSize>::readBigEndian(const byte* inData,
+                                                                                        unsigned inSize)
+{
+    unsigned long value = 0;
+    for (unsigned i = 0; i < inSize; ++i)
+    {
+        value = (value << 8) | inData[i];
+    }
+    return value;
+}
+
+END_MIDI_NAMESPACE
@@ -0,0 +1,182 @@
+/*!
+ *  @file       midi_Statistics.h
+ *  Project     Arduino MIDI Library
+ *  @brief      MIDI Library for the Arduino - Input instrumentation
+ *  @author     Francois Best
+ *  @date       17/10/2026
+ *  @license    MIT - Copyright (c) 2026 Francois Best
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+
+#pragma once
+
+#include "midi_Defs.h"
+
+BEGIN_MIDI_NAMESPACE
+
+/*! \brief Counters of the input hot path, see DefaultSettings::UseStatistics.
+
+ MidiInterface records what it parses, and getStatistics() hands over a copy.
+ Counters are not updated atomically: when feed() is called from an
+ interrupt, take the snapshot with interrupts disabled.
+
+ The latency histogram counts messages by the time elapsed between their
+ first byte and their dispatch (callbacks and Thru), in Platform::now()
+ units. Bucket 0 holds durations of 0, bucket n durations from 2^(n-1) to
+ 2^n - 1, and the last bucket everything longer. It needs the receive time
+ of each message, so it is only filled with DefaultSettings::UseReceiveTimestamps.
+ */
+template<bool Enabled>
+class Statistics
+{
+public:
+    static const unsigned NumTypes             = 24;
+    static const unsigned NumLatencyBuckets    = 16;
+
+public:
+    inline Statistics()
+    {
+        reset();
+    }
+
+    inline void reset()
+    {
+        mBytes              = 0;
+        mSysExOverflows     = 0;
+        mInvalidStatusBytes = 0;
+        mStrayDataBytes     = 0;
+        mQueueOverruns      = 0;
+        for (unsigned i = 0; i < NumTypes; ++i)
+        {
+            mMessages[i] = 0;
+        }
+        for (unsigned i = 0; i < NumLatencyBuckets; ++i)
+        {
+            mLatencies[i] = 0;
+        }
+    }
+
+public:
+    inline unsigned long getBytes() const               { return mBytes; }
+    inline unsigned long getSysExOverflows() const      { return mSysExOverflows; }
+    inline unsigned long getInvalidStatusBytes() const  { return mInvalidStatusBytes; }
+    inline unsigned long getStrayDataBytes() const      { return mStrayDataBytes; }
+    inline unsigned long getQueueOverruns() const       { return mQueueOverruns; }
+
+    inline unsigned long getMessages(MidiType inType) const
+    {
+        return mMessages[getTypeIndex(inType)];
+    }
+
+    inline unsigned long getMessages() const
+    {
+        unsigned long total = 0;
+        for (unsigned i = 0; i < NumTypes; ++i)
+        {
+            total += mMessages[i];
+        }
+        return total;
+    }
+
+    inline unsigned long getLatencies(unsigned inBucket) const
+    {
+        return inBucket < NumLatencyBuckets ? mLatencies[inBucket] : 0;
+    }
+
+public:
+    inline void countByte()                             { mBytes++; }
+    inline void countSysExOverflow()                    { mSysExOverflows++; }
+    inline void countInvalidStatusByte()                { mInvalidStatusBytes++; }
+    inline void countStrayDataByte()                    { mStrayDataBytes++; }
+    inline void countQueueOverrun()                     { mQueueOverruns++; }
+
+    inline void countMessage(MidiType inType)
+    {
+        mMessages[getTypeIndex(inType)]++;
+    }
+
+    inline void countLatency(unsigned long inDuration)
+    {
+        mLatencies[getLatencyBucket(inDuration)]++;
+    }
+
+public:
+    static inline unsigned getLatencyBucket(unsigned long inDuration)
+    {
+        unsigned bucket = 0;
+        while (inDuration != 0 && bucket < NumLatencyBuckets - 1)
+        {
+            inDuration >>= 1;
+            bucket++;
+        }
+        return bucket;
+    }
+
+private:
+    // Channel messages by high nibble (0 to 6), then system messages by low
+    // nibble (8 to 23).
+    static inline unsigned getTypeIndex(MidiType inType)
+    {
+        return inType < 0xf0 ? (inType >> 4) & 0x07 : 0x08 + (inType & 0x0f);
+    }
+
+private:
+    unsigned long mBytes;
+    unsigned long mSysExOverflows;
+    unsigned long mInvalidStatusBytes;
+    unsigned long mStrayDataBytes;
+    unsigned long mQueueOverruns;
+    unsigned long mMessages[NumTypes];
+    unsigned long mLatencies[NumLatencyBuckets];
+};
+
+/*! Statistics compiled out: no storage, and every counter reads 0. */
+template<>
+class Statistics<false>
+{
+public:
+    static const unsigned NumTypes             = 24;
+    static const unsigned NumLatencyBuckets    = 16;
+
+public:
+    inline void reset()                                 { }
+
+public:
+    inline unsigned long getBytes() const               { return 0; }
+    inline unsigned long getSysExOverflows() const      { return 0; }
+    inline unsigned long getInvalidStatusBytes() const  { return 0; }
+    inline unsigned long getStrayDataBytes() const      { return 0; }
+    inline unsigned long getQueueOverruns() const       { return 0; }
+    inline unsigned long getMessages(MidiType) const    { return 0; }
+    inline unsigned long getMessages() const            { return 0; }
+    inline unsigned long getLatencies(unsigned) const   { return 0; }
+
+public:
+    inline void countByte()                             { }
+    inline void countSysExOverflow()                    { }
+    inline void countInvalidStatusByte()                { }
+    inline void countStrayDataByte()                    { }
+    inline void countQueueOverrun()                     { }
+    inline void countMessage(MidiType)                  { }
+    inline void countLatency(unsigned long)             { }
+};
+
+END_MIDI_NAMESPACE
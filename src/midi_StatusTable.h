@@ -0,0 +1,93 @@
+/*!
+ *  @file       midi_StatusTable.h
+ *  Project     Arduino MIDI Library
+ *  @brief      MIDI Library for the Arduino - Status byte lookup table
+ *  @author     Francois Best
+ *  @date       17/10/2026
+ *  @license    MIT - Copyright (c) 2026 Francois Best
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "midi_Defs.h"
+
+BEGIN_MIDI_NAMESPACE
+
+/*! \brief Properties of every status byte, looked up once per byte.
+
+ Channel messages only depend on the high nibble, and system messages on the
+ low nibble, so the table holds 32 entries instead of 256 to stay cheap on
+ RAM-constrained targets:
+ - 0x00 to 0x7f (data bytes) map to entries 0 to 7,
+ - 0x80 to 0xef (channel messages) map to entries 8 to 14,
+ - 0xf0 to 0xff (system messages) map to entries 16 to 31.
+ */
+struct StatusTable
+{
+    enum Flags
+    {
+        LengthMask      = 0x03, ///< Message length in bytes (0 for SysEx).
+        Defined         = 0x04, ///< The byte starts a message defined by the norm.
+        ChannelMessage  = 0x08, ///< Channel message, eligible to Running Status.
+        RealTime        = 0x10, ///< System Real Time, can be interleaved anywhere.
+    };
+
+    static inline byte getFlags(byte inStatus)
+    {
+        return sFlags[inStatus < 0xf0 ? inStatus >> 4 : 0x10 | (inStatus & 0x0f)];
+    }
+
+    static inline byte getLength(byte inStatus)
+    {
+        return getFlags(inStatus) & LengthMask;
+    }
+
+    static inline bool isDefined(byte inStatus)
+    {
+        return getFlags(inStatus) & Defined;
+    }
+
+    static inline bool isChannelMessage(byte inStatus)
+    {
+        return getFlags(inStatus) & ChannelMessage;
+    }
+
+    static inline bool isRealTime(byte inStatus)
+    {
+        return getFlags(inStatus) & RealTime;
+    }
+
+    static inline MidiType getType(byte inStatus)
+    {
+        const byte flags = getFlags(inStatus);
+        if (!(flags & Defined))
+        {
+            // Data bytes and undefined.
+            return InvalidType;
+        }
+        // Remove channel nibble from channel messages.
+        return MidiType(flags & ChannelMessage ? inStatus & 0xf0 : inStatus);
+    }
+
+    static const byte sFlags[32];
+};
+
+END_MIDI_NAMESPACE
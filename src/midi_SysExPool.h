@@ -0,0 +1,103 @@
+/*!
+ *  @file       midi_SysExPool.h
+ *  Project     Arduino MIDI Library
+ *  @brief      MIDI Library for the Arduino - Shared SysEx buffer pool
+ *  @author     Francois Best
+ *  @date       17/10/2026
+ *  @license    MIT - Copyright (c) 2026 Francois Best
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "midi_Defs.h"
+
+BEGIN_MIDI_NAMESPACE
+
+/*! \brief Fixed-size blocks to receive SysEx into, shared between instances.
+
+ A MidiInterface given a pool (see setSysExPool) borrows a block when a SysEx
+ frame starts and gives it back once the frame has been handled, so several
+ ports can receive large frames without each reserving its own buffer.
+
+ Drop policy: when all blocks are in use, the frame is received in the
+ instance's own buffer (SysExMaxSize bytes) and dropped if it does not fit.
+ Exhaustions are counted.
+
+ Blocks are borrowed and returned from the context that reads the ports,
+ a pool must not be shared between an interrupt and the main loop.
+ Use StaticSysExPool to declare one.
+ */
+class SysExPool
+{
+public:
+    byte* acquire();
+    void release(byte* inBlock);
+
+public:
+    inline unsigned getBlockSize() const        { return mBlockSize; }
+    inline unsigned getBlockCount() const       { return mBlockCount; }
+    inline unsigned getBlocksInUse() const      { return mBlocksInUse; }
+    inline unsigned getPeakBlocksInUse() const  { return mPeakBlocksInUse; }
+    inline unsigned getExhaustionCount() const  { return mExhaustionCount; }
+    void resetCounters();
+
+protected:
+    SysExPool(byte* inStorage, unsigned inBlockSize, unsigned inBlockCount);
+
+private:
+    SysExPool(const SysExPool&);
+    SysExPool& operator=(const SysExPool&);
+
+private:
+    byte* mStorage;
+    unsigned mBlockSize;
+    byte mBlockCount;
+    byte mBlocksInUse;
+    byte mPeakBlocksInUse;
+    unsigned long mUsedMask;
+    unsigned mExhaustionCount;
+};
+
+/*! \brief SysEx pool with its storage: BlockCount blocks (32 at most) of
+ BlockSize bytes.
+ \code{.cpp}
+ midi::StaticSysExPool<1024, 2> sysExPool; // 2 KB for 4 ports
+ MIDI1.setSysExPool(&sysExPool);
+ MIDI2.setSysExPool(&sysExPool);
+ \endcode
+ */
+template<unsigned BlockSize, unsigned BlockCount>
+class StaticSysExPool : public SysExPool
+{
+private:
+    typedef char BlockCountMustBeBetween1And32[(BlockCount > 0 && BlockCount <= 32) ? 1 : -1];
+
+public:
+    inline StaticSysExPool()
+        : SysExPool(mBlocks, BlockSize, BlockCount)
+    {
+    }
+
+private:
+    byte mBlocks[BlockSize * BlockCount];
+};
+
+END_MIDI_NAMESPACE
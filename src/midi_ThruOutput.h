@@ -0,0 +1,112 @@
+/*!
+ *  @file       midi_ThruOutput.h
+ *  Project     Arduino MIDI Library
+ *  @brief      MIDI Library for the Arduino - Additional Thru destinations
+ *  @author     Francois Best
+ *  @date       17/10/2026
+ *  @license    MIT - Copyright (c) 2026 Francois Best
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "midi_Defs.h"
+
+BEGIN_MIDI_NAMESPACE
+
+template<class SerialPort, class Settings, class Platform, class Handler>
+class MidiInterface;
+
+/*! \brief Destination for the Thru of a MidiInterface, besides its own port.
+
+ Received messages are encoded once, and the same bytes are written to every
+ output whose filter accepts them (the filter uses the input channel of the
+ interface, see Thru::Mode). Running Status is not used on these outputs.
+
+ An output is attached to a single interface: for a merger, create one output
+ per input, wrapping the same port.
+
+ Warning: an output writing to the port of another interface (as in a merger)
+ writes behind the back of that interface. Its own messages keep their
+ Running Status, and could then follow a foreign status byte without
+ repeating theirs: an interface sharing its port with a ThruOutput must not
+ use Settings::UseRunningStatus.
+ @see SerialThruOutput, MidiInterface::addThruOutput
+ */
+class ThruOutput
+{
+public:
+    inline ThruOutput(Thru::Mode inFilterMode = Thru::Full)
+        : mFilterMode(inFilterMode)
+        , mNext(0)
+    {
+    }
+
+public:
+    inline Thru::Mode getFilterMode() const              { return mFilterMode; }
+    inline void setFilterMode(Thru::Mode inFilterMode)  { mFilterMode = inFilterMode; }
+
+    /*! Write a complete message. */
+    virtual void write(const byte* inData, unsigned inSize) = 0;
+
+protected:
+    inline ~ThruOutput()
+    {
+    }
+
+private:
+    template<class SerialPort, class Settings, class Platform, class Handler>
+    friend class MidiInterface;
+
+    Thru::Mode mFilterMode;
+    ThruOutput* mNext;
+};
+
+/*! \brief Thru output writing to a serial port, or any class with a
+ write(byte) method.
+ \code{.cpp}
+ midi::SerialThruOutput<HardwareSerial> thruToSerial2(Serial2);
+ MIDI.addThruOutput(thruToSerial2);
+ \endcode
+ */
+template<class SerialPort>
+class SerialThruOutput : public ThruOutput
+{
+public:
+    inline SerialThruOutput(SerialPort& inSerial, Thru::Mode inFilterMode = Thru::Full)
+        : ThruOutput(inFilterMode)
+        , mSerial(inSerial)
+    {
+    }
+
+public:
+    virtual void write(const byte* inData, unsigned inSize)
+    {
+        for (unsigned i = 0; i < inSize; ++i)
+        {
+            mSerial.write(inData[i]);
+        }
+    }
+
+private:
+    SerialPort& mSerial;
+};
+
+END_MIDI_NAMESPACE
@@ -29,10 +29,12 @@
 
 #include "midi_Defs.h"
 #include "midi_RingBuffer.h"
+#include "midi_StatusTable.h"
 #include <MIDIUSB.h>
 
 BEGIN_MIDI_NAMESPACE
 
+/*! USB MIDI transport (cable 0), BuffersSize must be a power of two. */
 template<unsigned BuffersSize>
 class UsbTransport
 {
@@ -45,6 +47,7 @@ public: // Serial / Stream API required for template compatibility
     inline unsigned available();
     inline byte read();
     inline void write(byte inData);
+    inline void write(const byte* inData, unsigned inSize);
 
 private:
     inline bool pollUsbMidi();
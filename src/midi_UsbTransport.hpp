@@ -70,6 +70,21 @@ inline void UsbTransport<BufferSize>::write(byte inData)
     recomposeAndSendTxPackets();
 }
 
+template<unsigned BufferSize>
+inline void UsbTransport<BufferSize>::write(const byte* inData, unsigned inSize)
+{
+    // Packets are sent as the buffer is emptied, so it is free again
+    // after each block.
+    while (inSize > 0)
+    {
+        const unsigned size = inSize < BufferSize ? inSize : BufferSize;
+        mTxBuffer.write(inData, int(size));
+        recomposeAndSendTxPackets();
+        inData += size;
+        inSize -= size;
+    }
+}
+
 // -----------------------------------------------------------------------------
 
 template<unsigned BufferSize>
@@ -81,46 +96,17 @@ inline bool UsbTransport<BufferSize>::pollUsbMidi()
     {
         received = true;
 
-        switch (packet.header << 4)
+        // Only cable 0 is handled, SysEx is not supported yet.
+        if ((packet.header >> 4) == 0)
         {
-                // 3 bytes messages
-            case midi::NoteOff:
-            case midi::NoteOn:
-            case midi::AfterTouchPoly:
-            case midi::ControlChange:
-            case midi::PitchBend:
-                mRxBuffer.write(packet.byte1);
-                mRxBuffer.write(packet.byte2);
-                mRxBuffer.write(packet.byte3);
-                break;
-
-                // 2 bytes messages
-            case midi::ProgramChange:
-            case midi::AfterTouchChannel:
-                mRxBuffer.write(packet.byte1);
-                mRxBuffer.write(packet.byte2);
-                break;
-
-                // 1 byte message
-            case midi::TuneRequest:
-            case midi::Clock:
-            case midi::Start:
-            case midi::Continue:
-            case midi::Stop:
-            case midi::ActiveSensing:
-            case midi::SystemReset:
-                mRxBuffer.write(packet.byte1);
-                break;
-
-                // Special cases
-                // case midi::SystemExclusive:
-                // case midi::TimeCodeQuarterFrame:
-                // case midi::SongPosition:
-                // case midi::SongSelect:
-                //   break;
-
-            default:
-                break;
+            // Message length comes from the status byte,
+            // SysEx data and EOX packets are ignored (length 0).
+            // Messages that do not fit are dropped whole.
+            const byte length = StatusTable::getLength(packet.byte1);
+            if (int(BufferSize) - mRxBuffer.getLength() >= length)
+            {
+                mRxBuffer.write(&packet.byte1, length);
+            }
         }
 
         packet = MidiUSB.read();
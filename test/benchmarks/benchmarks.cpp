@@ -0,0 +1,175 @@
+#include "benchmarks.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+BEGIN_BENCHMARKS_NAMESPACE
+
+BEGIN_UNNAMED_NAMESPACE
+
+struct Entry
+{
+    std::string mName;
+    Function mFunction;
+};
+
+std::vector<Entry>& getRegistry()
+{
+    static std::vector<Entry> registry;
+    return registry;
+}
+
+double ratio(uint64_t inValue, uint64_t inCount)
+{
+    return inCount != 0 ? double(inValue) / double(inCount) : 0.0;
+}
+
+END_UNNAMED_NAMESPACE
+
+// -----------------------------------------------------------------------------
+
+Session::Session(Counters& inCounters)
+    : mCounters(inCounters)
+    , mBytes(0)
+    , mMessages(0)
+    , mCycles(0)
+    , mBranchMisses(0)
+    , mNanoseconds(0)
+    , mSink(0)
+    , mReportCount(0)
+    , mStopped(false)
+{
+}
+
+void Session::start()
+{
+    mCounters.start();
+}
+
+void Session::stop(uint64_t inBytes, uint64_t inMessages)
+{
+    mCounters.stop();
+    mBytes          = inBytes;
+    mMessages       = inMessages;
+    mCycles         = mCounters.getCycles();
+    mBranchMisses   = mCounters.getBranchMisses();
+    mNanoseconds    = mCounters.getNanoseconds();
+    mStopped        = true;
+}
+
+void Session::consume(uint64_t inValue)
+{
+    mSink += inValue;
+}
+
+void Session::report(const char* inName, uint64_t inValue)
+{
+    if (mReportCount < MaxReports)
+    {
+        mReportNames[mReportCount]  = inName;
+        mReportValues[mReportCount] = inValue;
+        mReportCount++;
+    }
+}
+
+Registration::Registration(const char* inGroup, const char* inName, Function inFunction)
+{
+    Entry entry;
+    entry.mName = std::string(inGroup) + "." + inName;
+    entry.mFunction = inFunction;
+    getRegistry().push_back(entry);
+}
+
+END_BENCHMARKS_NAMESPACE
+
+// -----------------------------------------------------------------------------
+
+USING_NAMESPACE_BENCHMARKS
+
+int main(int argc, char** argv)
+{
+    const char* filter = 0;
+    int repetitions = 5;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--repetitions") == 0 && i + 1 < argc)
+        {
+            repetitions = atoi(argv[++i]);
+        }
+        else
+        {
+            filter = argv[i];
+        }
+    }
+
+    Counters counters;
+    printf("cycles: %s, branch misses: %s, best of %d runs\n\n",
+           counters.getCyclesSource(),
+           counters.hasBranchMisses() ? "perf branch-misses" : "unavailable",
+           repetitions);
+    printf("%-44s %10s %9s %9s %9s %12s %9s\n",
+           "benchmark", "bytes", "ns/byte", "cyc/byte", "bm/byte", "msg/s", "cyc/msg");
+
+    const std::vector<Entry>& registry = getRegistry();
+    for (unsigned i = 0; i < registry.size(); ++i)
+    {
+        const Entry& entry = registry[i];
+        if (filter != 0 && entry.mName.find(filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        Session best(counters);
+        for (int run = 0; run < repetitions; ++run)
+        {
+            Session session(counters);
+            entry.mFunction(session);
+            if (!session.mStopped)
+            {
+                fprintf(stderr, "%s: missing call to stop()\n", entry.mName.c_str());
+                return 1;
+            }
+            if (!best.mStopped || session.mNanoseconds < best.mNanoseconds)
+            {
+                best.mBytes         = session.mBytes;
+                best.mMessages      = session.mMessages;
+                best.mCycles        = session.mCycles;
+                best.mBranchMisses  = session.mBranchMisses;
+                best.mNanoseconds   = session.mNanoseconds;
+                best.mReportCount   = session.mReportCount;
+                for (unsigned r = 0; r < session.mReportCount; ++r)
+                {
+                    best.mReportNames[r]  = session.mReportNames[r];
+                    best.mReportValues[r] = session.mReportValues[r];
+                }
+                best.mStopped       = true;
+            }
+        }
+
+        char branchMisses[16] = "n/a";
+        if (counters.hasBranchMisses())
+        {
+            snprintf(branchMisses, sizeof(branchMisses), "%.3f",
+                     ratio(best.mBranchMisses, best.mBytes));
+        }
+
+        const double seconds = double(best.mNanoseconds) * 1e-9;
+        printf("%-44s %10llu %9.2f %9.2f %9s %12.0f %9.1f\n",
+               entry.mName.c_str(),
+               (unsigned long long)best.mBytes,
+               ratio(best.mNanoseconds, best.mBytes),
+               ratio(best.mCycles, best.mBytes),
+               branchMisses,
+               seconds > 0.0 ? double(best.mMessages) / seconds : 0.0,
+               ratio(best.mCycles, best.mMessages));
+
+        for (unsigned r = 0; r < best.mReportCount; ++r)
+        {
+            printf("    %s: %llu\n", best.mReportNames[r], (unsigned long long)best.mReportValues[r]);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "benchmarks_Namespace.h"
+#include "benchmarks_Counters.h"
+#include <inttypes.h>
+
+BEGIN_BENCHMARKS_NAMESPACE
+
+/*! Measurement context handed to each benchmark.
+
+ A benchmark prepares its input, then surrounds the code under test with
+ start() and stop(). It is run several times and the fastest run is reported.
+ */
+class Session
+{
+public:
+    explicit Session(Counters& inCounters);
+
+public:
+    void start();
+    void stop(uint64_t inBytes, uint64_t inMessages);
+
+    /*! Prevent the compiler from optimising away results */
+    void consume(uint64_t inValue);
+
+    /*! Report an extra result, printed for the fastest run (up to MaxReports) */
+    void report(const char* inName, uint64_t inValue);
+
+public:
+    static const unsigned MaxReports = 4;
+
+public:
+    Counters& mCounters;
+    uint64_t mBytes;
+    uint64_t mMessages;
+    uint64_t mCycles;
+    uint64_t mBranchMisses;
+    uint64_t mNanoseconds;
+    uint64_t mSink;
+    const char* mReportNames[MaxReports];
+    uint64_t mReportValues[MaxReports];
+    unsigned mReportCount;
+    bool mStopped;
+};
+
+typedef void (*Function)(Session& inSession);
+
+struct Registration
+{
+    Registration(const char* inGroup, const char* inName, Function inFunction);
+};
+
+#define BENCHMARK(Group, Name)                                                  \
+    void Group##_##Name##_Benchmark(BENCHMARKS_NAMESPACE::Session& session);    \
+    BENCHMARKS_NAMESPACE::Registration Group##_##Name##_Registration(           \
+        #Group, #Name, Group##_##Name##_Benchmark);                             \
+    void Group##_##Name##_Benchmark(BENCHMARKS_NAMESPACE::Session& session)
+
+END_BENCHMARKS_NAMESPACE
@@ -0,0 +1,146 @@
+#include "benchmarks.h"
+#include "benchmarks_Traffic.h"
+#include <src/MIDI.h>
+#include <test/mocks/test-mocks_SerialMock.h>
+
+BEGIN_UNNAMED_NAMESPACE
+
+USING_NAMESPACE_BENCHMARKS
+
+typedef test_mocks::SerialMock<32> SerialMock;
+
+static const unsigned sNumMessages = 200000;
+
+const Stream& getMixedTraffic()
+{
+    static Stream stream;
+    if (stream.empty())
+    {
+        Random random;
+        appendMixedTraffic(stream, sNumMessages, random);
+    }
+    return stream;
+}
+
+uint64_t sNotes = 0;
+uint64_t sControls = 0;
+uint64_t sClocks = 0;
+
+void handleNoteOn(byte inChannel, byte inNote, byte inVelocity)
+{
+    sNotes += inChannel + inNote + inVelocity;
+}
+
+void handleControlChange(byte inChannel, byte inNumber, byte inValue)
+{
+    sControls += inChannel + inNumber + inValue;
+}
+
+void handleClock()
+{
+    sClocks++;
+}
+
+struct CountingHandler : public midi::StaticHandler
+{
+    static inline void handleNoteOn(byte inChannel, byte inNote, byte inVelocity)
+    {
+        sNotes += inChannel + inNote + inVelocity;
+    }
+    static inline void handleControlChange(byte inChannel, byte inNumber, byte inValue)
+    {
+        sControls += inChannel + inNumber + inValue;
+    }
+    static inline void handleClock()
+    {
+        sClocks++;
+    }
+};
+
+typedef midi::MidiInterface<SerialMock> MidiInterface;
+
+struct Counter
+{
+    void noteOn(byte inChannel, byte inNote, byte inVelocity)
+    {
+        sNotes += inChannel + inNote + inVelocity;
+    }
+    void controlChange(byte inChannel, byte inNumber, byte inValue)
+    {
+        sControls += inChannel + inNumber + inValue;
+    }
+    void clock()
+    {
+        sClocks++;
+    }
+    void message(const MidiInterface::MidiMessage& inMessage)
+    {
+        switch (inMessage.type)
+        {
+            case midi::NoteOn:          noteOn(inMessage.channel, inMessage.data1, inMessage.data2);        break;
+            case midi::ControlChange:   controlChange(inMessage.channel, inMessage.data1, inMessage.data2); break;
+            case midi::Clock:           clock();                                                            break;
+            default:                                                                                        break;
+        }
+    }
+};
+
+template<class Interface>
+void parse(Session& session, Interface& inMidi)
+{
+    const Stream& stream = getMixedTraffic();
+    inMidi.begin(MIDI_CHANNEL_OMNI);
+    inMidi.turnThruOff();
+    sNotes = sControls = sClocks = 0;
+
+    session.start();
+    const unsigned count = inMidi.read(&stream[0], unsigned(stream.size()));
+    session.stop(stream.size(), count);
+    session.consume(sNotes + sControls + sClocks);
+}
+
+// -----------------------------------------------------------------------------
+
+BENCHMARK(Handlers, callbacks)
+{
+    SerialMock serial;
+    MidiInterface midi(serial);
+    midi.setHandleNoteOn(handleNoteOn);
+    midi.setHandleControlChange(handleControlChange);
+    midi.setHandleClock(handleClock);
+    parse(session, midi);
+}
+
+BENCHMARK(Handlers, delegates)
+{
+    typedef midi::Delegate<void(byte, byte, byte)> ChannelDelegate;
+    SerialMock serial;
+    MidiInterface midi(serial);
+    Counter counter;
+    midi.setHandleNoteOn(ChannelDelegate::bind<Counter, &Counter::noteOn>(&counter));
+    midi.setHandleControlChange(ChannelDelegate::bind<Counter, &Counter::controlChange>(&counter));
+    midi.setHandleClock(midi::Delegate<void()>::bind<Counter, &Counter::clock>(&counter));
+    parse(session, midi);
+}
+
+BENCHMARK(Handlers, messageDelegate)
+{
+    typedef midi::Delegate<void(const MidiInterface::MidiMessage&)> MessageDelegate;
+    SerialMock serial;
+    MidiInterface midi(serial);
+    Counter counter;
+    midi.setHandleMessage(MessageDelegate::bind<Counter, &Counter::message>(&counter));
+    parse(session, midi);
+}
+
+BENCHMARK(Handlers, staticPolicy)
+{
+    SerialMock serial;
+    midi::MidiInterface<SerialMock,
+                        midi::DefaultSettings,
+                        midi::DefaultPlatform,
+                        CountingHandler> midi(serial);
+    parse(session, midi);
+}
+
+END_UNNAMED_NAMESPACE
@@ -0,0 +1,69 @@
+#include "benchmarks.h"
+#include "benchmarks_Traffic.h"
+#include <src/MIDI.h>
+#include <test/mocks/test-mocks_SerialMock.h>
+
+BEGIN_UNNAMED_NAMESPACE
+
+USING_NAMESPACE_BENCHMARKS
+
+typedef test_mocks::SerialMock<32> SerialMock;
+
+template<unsigned SysExSize>
+struct QueueSettings : midi::DefaultSettings
+{
+    static const unsigned MessageQueueSize = 64;
+    static const unsigned SysExMaxSize = SysExSize;
+};
+
+static const unsigned sNumMessages  = 200000;
+static const unsigned sBurstSize    = 48;
+
+const Stream& getMixedTraffic()
+{
+    static Stream stream;
+    if (stream.empty())
+    {
+        Random random;
+        appendMixedTraffic(stream, sNumMessages, random);
+    }
+    return stream;
+}
+
+// -----------------------------------------------------------------------------
+
+// Bursts are pushed as from an interrupt, then drained by the main loop.
+template<unsigned SysExSize>
+void feedAndDrain(Session& session)
+{
+    typedef midi::MidiInterface<SerialMock, QueueSettings<SysExSize> > QueueMidiInterface;
+    const Stream& stream = getMixedTraffic();
+    SerialMock serial;
+    QueueMidiInterface midi(serial);
+    midi.begin(MIDI_CHANNEL_OMNI);
+    midi.turnThruOff();
+    unsigned count = 0;
+
+    session.start();
+    for (unsigned i = 0; i < stream.size(); i += sBurstSize)
+    {
+        const unsigned size = unsigned(stream.size()) - i < sBurstSize
+                            ? unsigned(stream.size()) - i
+                            : sBurstSize;
+        midi.feed(&stream[i], size);
+        count += midi.readMessages(sBurstSize);
+    }
+    session.stop(stream.size(), count);
+}
+
+BENCHMARK(MessageQueue, feedAndDrainSysEx128)
+{
+    feedAndDrain<128>(session);
+}
+
+BENCHMARK(MessageQueue, feedAndDrainSysEx1024)
+{
+    feedAndDrain<1024>(session);
+}
+
+END_UNNAMED_NAMESPACE
@@ -0,0 +1,219 @@
+#include "benchmarks.h"
+#include "benchmarks_Traffic.h"
+#include <src/MIDI.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+BEGIN_UNNAMED_NAMESPACE
+
+USING_NAMESPACE_BENCHMARKS
+
+static const unsigned sNumMessages = 20000;
+
+/*! Port writing to /dev/null, so that each write is a system call, as with
+ a file descriptor transport (ALSA raw MIDI, serial TTY, socket).
+ */
+class FileDescriptorPort
+{
+public:
+    FileDescriptorPort()
+        : mFd(open("/dev/null", O_WRONLY))
+        , mBytes(0)
+    {
+    }
+
+    ~FileDescriptorPort()
+    {
+        close(mFd);
+    }
+
+public:
+    void begin(long)
+    {
+    }
+
+    int available()
+    {
+        return 0;
+    }
+
+    byte read()
+    {
+        return 0;
+    }
+
+    void write(byte inData)
+    {
+        mBytes += ::write(mFd, &inData, 1);
+    }
+
+    void write(const byte* inData, unsigned inSize)
+    {
+        mBytes += ::write(mFd, inData, inSize);
+    }
+
+public:
+    int mFd;
+    uint64_t mBytes;
+};
+
+/*! Port counting the bytes sent, as a DIN link would carry them. */
+class CountingPort
+{
+public:
+    void begin(long)        { mBytes = 0; }
+    int available()         { return 0; }
+    byte read()             { return 0; }
+    void write(byte)        { mBytes++; }
+
+public:
+    uint64_t mBytes;
+};
+
+template<unsigned Size>
+struct BufferedSettings : midi::DefaultSettings
+{
+    static const unsigned OutputBufferSize = Size;
+};
+
+template<bool RunningStatus, bool NoteOffAsNoteOn>
+struct EncoderSettings : midi::DefaultSettings
+{
+    static const bool UseRunningStatus = RunningStatus;
+    static const bool SendNoteOffAsNullVelocityNoteOn = NoteOffAsNoteOn;
+};
+
+/*! Notes and controllers, flushed every 16 messages as an application
+ would do once per loop() iteration.
+ */
+template<unsigned Size>
+void sendMessages(Session& session)
+{
+    typedef midi::MidiInterface<FileDescriptorPort, BufferedSettings<Size> > BufferedMidiInterface;
+    FileDescriptorPort port;
+    BufferedMidiInterface midi(port);
+    Random random;
+    midi.begin();
+    port.mBytes = 0;
+
+    session.start();
+    for (unsigned i = 0; i < sNumMessages; ++i)
+    {
+        const midi::Channel channel = midi::Channel(1 + (i & 0x0f));
+        switch (random.below(4))
+        {
+            case 0:  midi.sendNoteOff(random.data(), random.data(), channel);         break;
+            case 1:  midi.sendControlChange(random.data(), random.data(), channel);   break;
+            default: midi.sendNoteOn(random.data(), random.data(), channel);          break;
+        }
+        if ((i & 0x0f) == 0x0f)
+        {
+            midi.flush();
+        }
+    }
+    midi.flush();
+    session.stop(port.mBytes, sNumMessages);
+}
+
+/*! The same messages, sent in batches of 16 with send(messages, count). */
+void sendBatches(Session& session)
+{
+    typedef midi::MidiInterface<FileDescriptorPort, BufferedSettings<64> > BufferedMidiInterface;
+    typedef BufferedMidiInterface::MidiMessage Message;
+    static const midi::MidiType sTypes[] = { midi::NoteOff, midi::ControlChange, midi::NoteOn, midi::NoteOn };
+
+    FileDescriptorPort port;
+    BufferedMidiInterface midi(port);
+    Random random;
+    Message batch[16];
+    midi.begin();
+    port.mBytes = 0;
+
+    session.start();
+    for (unsigned i = 0; i < sNumMessages; i += 16)
+    {
+        for (unsigned j = 0; j < 16; ++j)
+        {
+            batch[j].type    = sTypes[random.below(4)];
+            batch[j].channel = midi::Channel(1 + j);
+            batch[j].data1   = random.data();
+            batch[j].data2   = random.data();
+        }
+        midi.send(batch, 16);
+    }
+    session.stop(port.mBytes, sNumMessages);
+}
+
+/*! A legato line on one channel (each note released after the next one
+ starts), a CC sweep on another, and clocks in between, as a sequencer
+ would send them.
+ */
+template<bool RunningStatus, bool NoteOffAsNoteOn>
+void sendLegato(Session& session)
+{
+    typedef midi::MidiInterface<CountingPort, EncoderSettings<RunningStatus, NoteOffAsNoteOn> > EncoderMidiInterface;
+    CountingPort port;
+    EncoderMidiInterface midi(port);
+    Random random;
+    midi.begin();
+
+    byte previous = 60;
+    unsigned count = 0;
+    session.start();
+    for (unsigned i = 0; i < sNumMessages / 14; ++i)
+    {
+        for (unsigned n = 0; n < 4; ++n)
+        {
+            const byte note = byte(36 + random.below(48));
+            midi.sendNoteOn(note, 100, 1);
+            midi.sendNoteOff(previous, 64, 1);
+            previous = note;
+        }
+        midi.sendRealTime(midi::Clock);
+        for (unsigned value = 0; value < 4; ++value)
+        {
+            midi.sendControlChange(74, byte(i * 4 + value) & 0x7f, 2);
+        }
+        midi.sendRealTime(midi::Clock);
+        count += 14;
+    }
+    session.stop(port.mBytes, count);
+    session.consume(midi.getRunningStatusSavings());
+
+    // Each byte takes 10 bits on the wire.
+    session.report("time on a 31250 baud link (ms)", port.mBytes * 10 * 1000 / 31250);
+}
+
+END_UNNAMED_NAMESPACE
+
+// -----------------------------------------------------------------------------
+
+BENCHMARK(Output, unbuffered)
+{
+    sendMessages<0>(session);
+}
+
+BENCHMARK(Output, buffered64)
+{
+    sendMessages<64>(session);
+}
+
+BENCHMARK(Output, sendBatch64)
+{
+    sendBatches(session);
+}
+
+BENCHMARK(Output, legatoWithoutRunningStatus)
+{
+    sendLegato<false, false>(session);
+}
+
+BENCHMARK(Output, legatoRunningStatus)
+{
+    sendLegato<true, false>(session);
+}
+
+BENCHMARK(Output, legatoNoteOffAsNoteOn)
+{
+    sendLegato<true, true>(session);
+}
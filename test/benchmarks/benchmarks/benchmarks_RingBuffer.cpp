@@ -0,0 +1,104 @@
+#include "benchmarks.h"
+#include "benchmarks_Traffic.h"
+#include <src/midi_RingBuffer.h>
+
+BEGIN_UNNAMED_NAMESPACE
+
+USING_NAMESPACE_BENCHMARKS
+
+typedef midi::RingBuffer<byte, 256> Buffer;
+
+static const unsigned sNumMessages  = 200000;
+static const int sBlockSize         = 48; // Not a divider of the buffer size
+
+const Stream& getStream()
+{
+    static Stream stream;
+    if (stream.empty())
+    {
+        Random random;
+        appendMixedTraffic(stream, sNumMessages, random);
+    }
+    return stream;
+}
+
+// -----------------------------------------------------------------------------
+
+BENCHMARK(RingBuffer, elementLoop)
+{
+    const Stream& stream = getStream();
+    const int size = int(stream.size());
+    Buffer buffer;
+    byte block[sBlockSize];
+    uint64_t sum = 0;
+
+    session.start();
+    for (int i = 0; i + sBlockSize <= size; i += sBlockSize)
+    {
+        for (int j = 0; j < sBlockSize; ++j)
+        {
+            buffer.write(stream[i + j]);
+        }
+        for (int j = 0; j < sBlockSize; ++j)
+        {
+            block[j] = buffer.read();
+        }
+        sum += block[i % sBlockSize];
+    }
+    session.stop(stream.size(), 0);
+    session.consume(sum);
+}
+
+BENCHMARK(RingBuffer, blockCopy)
+{
+    const Stream& stream = getStream();
+    const int size = int(stream.size());
+    Buffer buffer;
+    byte block[sBlockSize];
+    uint64_t sum = 0;
+
+    session.start();
+    for (int i = 0; i + sBlockSize <= size; i += sBlockSize)
+    {
+        buffer.write(&stream[i], sBlockSize);
+        buffer.read(block, sBlockSize);
+        sum += block[i % sBlockSize];
+    }
+    session.stop(stream.size(), 0);
+    session.consume(sum);
+}
+
+BENCHMARK(RingBuffer, spans)
+{
+    const Stream& stream = getStream();
+    const int size = int(stream.size());
+    Buffer buffer;
+    uint64_t sum = 0;
+
+    session.start();
+    for (int i = 0; i + sBlockSize <= size; i += sBlockSize)
+    {
+        // Produce in place, consume in place
+        int written = 0;
+        while (written < sBlockSize)
+        {
+            int span = 0;
+            byte* data = buffer.getWriteSpan(span);
+            span = span < sBlockSize - written ? span : sBlockSize - written;
+            memcpy(data, &stream[i + written], span);
+            buffer.commitWrite(span);
+            written += span;
+        }
+        while (!buffer.isEmpty())
+        {
+            int span = 0;
+            const byte* data = buffer.getReadSpan(span);
+            sum += data[span - 1];
+            buffer.commitRead(span);
+        }
+    }
+    session.stop(stream.size(), 0);
+    session.consume(sum);
+}
+
+END_UNNAMED_NAMESPACE
@@ -0,0 +1,224 @@
+#include "benchmarks.h"
+#include "benchmarks_Traffic.h"
+#include <src/MIDI.h>
+#include <src/midi_Router.h>
+#include <test/mocks/test-mocks_SerialMock.h>
+
+BEGIN_UNNAMED_NAMESPACE
+
+USING_NAMESPACE_BENCHMARKS
+
+typedef test_mocks::SerialMock<256> SerialMock;
+
+struct RouterSettings : midi::DefaultSettings
+{
+    static const bool UseRealTimeFastPath = true;
+    static const unsigned MessageQueueSize = 16;
+    static const unsigned SysExMaxSize = 32;
+};
+
+typedef midi::MidiInterface<SerialMock, RouterSettings> MidiInterface;
+
+static const unsigned sNumPorts  = 16;
+static const unsigned sNumRounds = 20000;
+static const unsigned sNumTags   = 1 << 14;
+
+/*! One message received by an input. Messages are tagged with a sequence
+ number in their first two data bytes, to find when they were received.
+ */
+struct Arrival
+{
+    byte mInput;
+    byte mSize;
+    byte mData[16];
+};
+
+struct Traffic
+{
+    std::vector<Arrival> mArrivals;
+    std::vector<unsigned> mRoundEnds;
+    uint64_t mBytes;
+};
+
+uint64_t sReceived[sNumTags];
+
+void tag(Arrival& outArrival, unsigned inSequence)
+{
+    outArrival.mData[1] = byte(inSequence & 0x7f);
+    outArrival.mData[2] = byte((inSequence >> 7) & 0x7f);
+}
+
+/*! Every round, each port receives zero to three messages (0.9 on average):
+ notes and controllers on its own channel, clocks and 12-byte SysEx.
+ */
+const Traffic& getTraffic()
+{
+    static Traffic traffic;
+    if (!traffic.mArrivals.empty())
+        return traffic;
+
+    static const byte sTypes[] = { midi::NoteOn, midi::NoteOff, midi::ControlChange, midi::PitchBend };
+    Random random;
+    unsigned sequence = 0;
+    traffic.mBytes = 0;
+
+    for (unsigned round = 0; round < sNumRounds; ++round)
+    {
+        for (unsigned port = 0; port < sNumPorts; ++port)
+        {
+            const unsigned draw = random.below(20);
+            const unsigned count = draw < 8 ? 0 : draw < 17 ? 1 : 3;
+
+            for (unsigned i = 0; i < count; ++i)
+            {
+                Arrival arrival;
+                arrival.mInput = byte(port);
+                const unsigned kind = random.below(32);
+                if (kind == 0)
+                {
+                    arrival.mSize = 1;
+                    arrival.mData[0] = midi::Clock;
+                }
+                else if (kind == 1)
+                {
+                    arrival.mSize = 14;
+                    arrival.mData[0] = midi::SystemExclusive;
+                    tag(arrival, sequence++ % sNumTags);
+                    for (unsigned b = 3; b < 13; ++b)
+                    {
+                        arrival.mData[b] = random.data();
+                    }
+                    arrival.mData[13] = 0xf7;
+                }
+                else
+                {
+                    arrival.mSize = 3;
+                    arrival.mData[0] = byte(sTypes[random.below(4)] | port);
+                    tag(arrival, sequence++ % sNumTags);
+                }
+                traffic.mBytes += arrival.mSize;
+                traffic.mArrivals.push_back(arrival);
+            }
+        }
+        traffic.mRoundEnds.push_back(unsigned(traffic.mArrivals.size()));
+    }
+    return traffic;
+}
+
+template<bool Timed>
+class Output : public midi::ThruOutput
+{
+public:
+    Output()
+        : mBytes(0)
+        , mWorstLatency(0)
+    {
+    }
+
+    virtual void write(const byte* inData, unsigned inSize)
+    {
+        mBytes += inSize;
+        if (Timed && inSize >= 3)
+        {
+            const unsigned sequence = inData[1] | unsigned(inData[2]) << 7;
+            const uint64_t latency = getMonotonicNanoseconds() - sReceived[sequence];
+            if (latency > mWorstLatency)
+            {
+                mWorstLatency = latency;
+            }
+        }
+    }
+
+public:
+    uint64_t mBytes;
+    uint64_t mWorstLatency;
+};
+
+/*! 16 inputs merged into 16 outputs: each input goes to its own output, and
+ its channel messages to the next output too. Every round, the messages of
+ the round are received, then update() is called once.
+ */
+template<bool Timed>
+void runRouter(Session& inSession)
+{
+    const Traffic& traffic = getTraffic();
+
+    SerialMock* serials = new SerialMock[sNumPorts];
+    MidiInterface* inputs[sNumPorts];
+    Output<Timed>* outputs = new Output<Timed>[sNumPorts];
+    midi::Router<MidiInterface, sNumPorts, sNumPorts>* router =
+        new midi::Router<MidiInterface, sNumPorts, sNumPorts>();
+
+    for (unsigned port = 0; port < sNumPorts; ++port)
+    {
+        inputs[port] = new MidiInterface(serials[port]);
+        inputs[port]->begin();
+        router->addInput(*inputs[port]);
+        router->addOutput(outputs[port]);
+    }
+    for (unsigned port = 0; port < sNumPorts; ++port)
+    {
+        router->setRoute(port, port);
+        router->setRoute(port, (port + 1) % sNumPorts, 1u << port, midi::Route::ChannelMessages);
+    }
+
+    uint64_t messages = 0;
+    unsigned arrival = 0;
+
+    inSession.start();
+    for (unsigned round = 0; round < sNumRounds; ++round)
+    {
+        const uint64_t now = Timed ? getMonotonicNanoseconds() : 0;
+        for (; arrival < traffic.mRoundEnds[round]; ++arrival)
+        {
+            const Arrival& message = traffic.mArrivals[arrival];
+            if (Timed && message.mSize >= 3)
+            {
+                sReceived[message.mData[1] | unsigned(message.mData[2]) << 7] = now;
+            }
+            serials[message.mInput].mRxBuffer.write(message.mData, message.mSize);
+        }
+        messages += router->update();
+    }
+    for (unsigned count = 1; count != 0;)
+    {
+        count = router->update();
+        messages += count;
+    }
+    inSession.stop(traffic.mBytes, messages);
+
+    uint64_t bytes = 0;
+    uint64_t worstLatency = 0;
+    for (unsigned port = 0; port < sNumPorts; ++port)
+    {
+        bytes += outputs[port].mBytes;
+        if (outputs[port].mWorstLatency > worstLatency)
+        {
+            worstLatency = outputs[port].mWorstLatency;
+        }
+        delete inputs[port];
+    }
+    inSession.consume(bytes);
+    if (Timed)
+    {
+        inSession.report("worst-case added latency (ns)", worstLatency);
+    }
+
+    delete router;
+    delete[] outputs;
+    delete[] serials;
+}
+
+END_UNNAMED_NAMESPACE
+
+// -----------------------------------------------------------------------------
+
+BENCHMARK(Router, sixteenPorts)
+{
+    runRouter<false>(session);
+}
+
+BENCHMARK(Router, sixteenPortsLatency)
+{
+    runRouter<true>(session);
+}
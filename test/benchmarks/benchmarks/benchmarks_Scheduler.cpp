@@ -0,0 +1,82 @@
+#include "benchmarks.h"
+#include "benchmarks_Traffic.h"
+#include <src/MIDI.h>
+#include <src/midi_Scheduler.h>
+
+BEGIN_UNNAMED_NAMESPACE
+
+USING_NAMESPACE_BENCHMARKS
+
+static const unsigned sNumMessages = 200000;
+
+/*! Port counting the bytes sent. */
+class CountingPort
+{
+public:
+    void begin(long)                        { mBytes = 0; }
+    int available()                         { return 0; }
+    byte read()                             { return 0; }
+    void write(byte)                        { mBytes++; }
+    void write(const byte*, unsigned inSize) { mBytes += inSize; }
+
+public:
+    uint64_t mBytes;
+};
+
+struct BufferedSettings : midi::DefaultSettings
+{
+    static const unsigned OutputBufferSize = 64;
+};
+
+typedef midi::MidiInterface<CountingPort, BufferedSettings> MidiInterface;
+
+/*! A sequencer keeping Capacity notes pending, scheduled up to 100 ms ahead
+ with a clock every 20 ms, serviced every millisecond of a simulated clock.
+ */
+template<unsigned Capacity>
+void scheduleAndService(Session& session)
+{
+    CountingPort port;
+    MidiInterface midi(port);
+    midi::Scheduler<MidiInterface, Capacity> scheduler(midi);
+    Random random;
+    midi.begin();
+
+    unsigned long now = 0;
+    unsigned long nextClock = 0;
+    unsigned scheduled = 0;
+    unsigned sent = 0;
+
+    session.start();
+    while (sent < sNumMessages)
+    {
+        while (scheduled < sNumMessages && scheduler.getLength() < Capacity)
+        {
+            const unsigned long due = now + random.below(100000);
+            scheduler.schedule(due, midi::NoteOn, random.data(), random.data(), 1 + random.below(16));
+            scheduled++;
+        }
+        if (long(now - nextClock) >= 0)
+        {
+            scheduler.scheduleRealTime(nextClock, midi::Clock);
+            nextClock += 20000;
+        }
+        sent += scheduler.service(now);
+        now += 1000;
+    }
+    session.stop(port.mBytes, sent);
+}
+
+END_UNNAMED_NAMESPACE
+
+// -----------------------------------------------------------------------------
+
+BENCHMARK(Scheduler, pending32)
+{
+    scheduleAndService<32>(session);
+}
+
+BENCHMARK(Scheduler, pending256)
+{
+    scheduleAndService<256>(session);
+}
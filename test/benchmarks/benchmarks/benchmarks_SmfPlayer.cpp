@@ -0,0 +1,145 @@
+#include "benchmarks.h"
+#include "benchmarks_Traffic.h"
+#include <src/MIDI.h>
+#include <src/midi_SmfPlayer.h>
+
+BEGIN_UNNAMED_NAMESPACE
+
+USING_NAMESPACE_BENCHMARKS
+
+static const unsigned sNotesPerTrack = 20000;
+
+/*! Port counting the bytes sent. */
+class CountingPort
+{
+public:
+    void begin(long)                        { mBytes = 0; }
+    int available()                         { return 0; }
+    byte read()                             { return 0; }
+    void write(byte)                        { mBytes++; }
+    void write(const byte*, unsigned inSize) { mBytes += inSize; }
+
+public:
+    uint64_t mBytes;
+};
+
+struct BufferedSettings : midi::DefaultSettings
+{
+    static const unsigned OutputBufferSize = 64;
+};
+
+typedef midi::MidiInterface<CountingPort, BufferedSettings> MidiInterface;
+
+void appendBigEndian(Stream& ioFile, unsigned long inValue, unsigned inSize)
+{
+    for (unsigned i = inSize; i > 0; --i)
+    {
+        ioFile.push_back(byte(inValue >> (8 * (i - 1))));
+    }
+}
+
+void appendVariableLength(Stream& ioFile, unsigned long inValue)
+{
+    for (unsigned shift = 21; shift > 0; shift -= 7)
+    {
+        if (inValue >> shift)
+        {
+            ioFile.push_back(byte(0x80 | ((inValue >> shift) & 0x7f)));
+        }
+    }
+    ioFile.push_back(byte(inValue & 0x7f));
+}
+
+/*! Format 1 file of Tracks tracks of NoteOn/NoteOff pairs in Running Status,
+ at random intervals, with a tempo change every 64 notes on the first one.
+ */
+template<unsigned Tracks>
+const Stream& getFile()
+{
+    static Stream file;
+    if (file.empty())
+    {
+        Random random;
+        static const byte header[8] = { 'M', 'T', 'h', 'd', 0, 0, 0, 6 };
+        file.assign(header, header + 8);
+        appendBigEndian(file, 1, 2);
+        appendBigEndian(file, Tracks, 2);
+        appendBigEndian(file, 480, 2);
+
+        for (unsigned t = 0; t < Tracks; ++t)
+        {
+            Stream track;
+            for (unsigned i = 0; i < sNotesPerTrack; ++i)
+            {
+                if (t == 0 && i % 64 == 0)
+                {
+                    static const byte tempo[3] = { 0xff, 0x51, 0x03 };
+                    track.push_back(0);
+                    track.insert(track.end(), tempo, tempo + 3);
+                    appendBigEndian(track, 400000 + random.below(200000), 3);
+                }
+                const byte note = random.data();
+                appendVariableLength(track, random.below(240));
+                track.push_back(byte(0x90 | (t & 0x0f)));
+                track.push_back(note);
+                track.push_back(100);
+                appendVariableLength(track, random.below(240));
+                track.push_back(note);
+                track.push_back(0);
+            }
+            static const byte endOfTrack[4] = { 0x00, 0xff, 0x2f, 0x00 };
+            track.insert(track.end(), endOfTrack, endOfTrack + 4);
+
+            static const byte chunk[4] = { 'M', 'T', 'r', 'k' };
+            file.insert(file.end(), chunk, chunk + 4);
+            appendBigEndian(file, track.size(), 4);
+            file.insert(file.end(), track.begin(), track.end());
+        }
+    }
+    return file;
+}
+
+/*! Play the whole file from memory, serviced every millisecond of a
+ simulated clock.
+ */
+template<unsigned Tracks, unsigned BufferSize>
+void playFile(Session& session)
+{
+    const Stream& file = getFile<Tracks>();
+    CountingPort port;
+    MidiInterface midi(port);
+    midi::SmfMemorySource source(&file[0], file.size());
+    midi::SmfPlayer<MidiInterface, midi::SmfMemorySource, Tracks, BufferSize> player(midi);
+    midi.begin();
+
+    session.start();
+    uint64_t sent = 0;
+    if (player.open(source))
+    {
+        player.start(0);
+        for (unsigned long now = 0; player.isPlaying(); now += 1000)
+        {
+            sent += player.service(now);
+        }
+    }
+    session.stop(port.mBytes, sent);
+}
+
+END_UNNAMED_NAMESPACE
+
+// -----------------------------------------------------------------------------
+
+BENCHMARK(SmfPlayer, tracks1)
+{
+    playFile<1, 16>(session);
+}
+
+BENCHMARK(SmfPlayer, tracks16)
+{
+    playFile<16, 16>(session);
+}
+
+BENCHMARK(SmfPlayer, tracks16Buffer64)
+{
+    playFile<16, 64>(session);
+}
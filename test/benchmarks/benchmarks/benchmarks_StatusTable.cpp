@@ -0,0 +1,197 @@
+#include "benchmarks.h"
+#include "benchmarks_Traffic.h"
+#include <src/MIDI.h>
+#include <test/mocks/test-mocks_SerialMock.h>
+
+BEGIN_UNNAMED_NAMESPACE
+
+USING_NAMESPACE_BENCHMARKS
+
+typedef test_mocks::SerialMock<32> SerialMock;
+typedef midi::MidiInterface<SerialMock> MidiInterface;
+
+struct TimestampSettings : midi::DefaultSettings
+{
+    static const bool UseReceiveTimestamps = true;
+};
+
+struct StatisticsSettings : midi::DefaultSettings
+{
+    static const bool UseStatistics = true;
+};
+
+typedef midi::MidiInterface<SerialMock, TimestampSettings> TimestampInterface;
+typedef midi::MidiInterface<SerialMock, StatisticsSettings> StatisticsInterface;
+
+static const unsigned sNumMessages = 200000;
+
+const Stream& getMixedTraffic()
+{
+    static Stream stream;
+    if (stream.empty())
+    {
+        Random random;
+        appendMixedTraffic(stream, sNumMessages, random);
+    }
+    return stream;
+}
+
+// -----------------------------------------------------------------------------
+// Reference: the switch cascade used by the parser before the status table.
+
+midi::MidiType legacyGetTypeFromStatusByte(byte inStatus)
+{
+    if ((inStatus  < 0x80) ||
+        (inStatus == 0xf4) ||
+        (inStatus == 0xf5) ||
+        (inStatus == 0xf9) ||
+        (inStatus == 0xfD))
+    {
+        return midi::InvalidType;
+    }
+    if (inStatus < 0xf0)
+    {
+        return midi::MidiType(inStatus & 0xf0);
+    }
+    return midi::MidiType(inStatus);
+}
+
+bool legacyIsChannelMessage(midi::MidiType inType)
+{
+    return (inType == midi::NoteOff           ||
+            inType == midi::NoteOn            ||
+            inType == midi::ControlChange     ||
+            inType == midi::AfterTouchPoly    ||
+            inType == midi::AfterTouchChannel ||
+            inType == midi::PitchBend         ||
+            inType == midi::ProgramChange);
+}
+
+unsigned legacyGetLength(midi::MidiType inType)
+{
+    switch (inType)
+    {
+        case midi::Start:
+        case midi::Continue:
+        case midi::Stop:
+        case midi::Clock:
+        case midi::ActiveSensing:
+        case midi::SystemReset:
+        case midi::TuneRequest:
+            return 1;
+
+        case midi::ProgramChange:
+        case midi::AfterTouchChannel:
+        case midi::TimeCodeQuarterFrame:
+        case midi::SongSelect:
+            return 2;
+
+        case midi::NoteOn:
+        case midi::NoteOff:
+        case midi::ControlChange:
+        case midi::PitchBend:
+        case midi::AfterTouchPoly:
+        case midi::SongPosition:
+            return 3;
+
+        default:
+            return 0;
+    }
+}
+
+bool legacyIsRealTime(byte inStatus)
+{
+    switch (inStatus)
+    {
+        case midi::Clock:
+        case midi::Start:
+        case midi::Continue:
+        case midi::Stop:
+        case midi::ActiveSensing:
+        case midi::SystemReset:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+BENCHMARK(StatusDecoding, switchCascade)
+{
+    const Stream& stream = getMixedTraffic();
+    uint64_t sum = 0;
+
+    session.start();
+    for (unsigned i = 0; i < stream.size(); ++i)
+    {
+        const midi::MidiType type = legacyGetTypeFromStatusByte(stream[i]);
+        sum += type;
+        sum += legacyGetLength(type);
+        sum += legacyIsChannelMessage(type) ? 1 : 0;
+        sum += legacyIsRealTime(stream[i]) ? 2 : 0;
+    }
+    session.stop(stream.size(), sNumMessages);
+    session.consume(sum);
+}
+
+BENCHMARK(StatusDecoding, lookupTable)
+{
+    const Stream& stream = getMixedTraffic();
+    uint64_t sum = 0;
+
+    session.start();
+    for (unsigned i = 0; i < stream.size(); ++i)
+    {
+        const byte flags = midi::StatusTable::getFlags(stream[i]);
+        sum += midi::StatusTable::getType(stream[i]);
+        sum += flags & midi::StatusTable::LengthMask;
+        sum += flags & midi::StatusTable::ChannelMessage ? 1 : 0;
+        sum += flags & midi::StatusTable::RealTime ? 2 : 0;
+    }
+    session.stop(stream.size(), sNumMessages);
+    session.consume(sum);
+}
+
+BENCHMARK(Parser, mixedTraffic)
+{
+    const Stream& stream = getMixedTraffic();
+    SerialMock serial;
+    MidiInterface midi(serial);
+    midi.begin(MIDI_CHANNEL_OMNI);
+    midi.turnThruOff();
+
+    session.start();
+    const unsigned count = midi.read(&stream[0], unsigned(stream.size()));
+    session.stop(stream.size(), count);
+}
+
+BENCHMARK(Parser, mixedTrafficTimestamps)
+{
+    const Stream& stream = getMixedTraffic();
+    SerialMock serial;
+    TimestampInterface midi(serial);
+    midi.begin(MIDI_CHANNEL_OMNI);
+    midi.turnThruOff();
+
+    session.start();
+    const unsigned count = midi.read(&stream[0], unsigned(stream.size()));
+    session.stop(stream.size(), count);
+    session.consume(midi.getTimestamp());
+}
+
+BENCHMARK(Parser, mixedTrafficStatistics)
+{
+    const Stream& stream = getMixedTraffic();
+    SerialMock serial;
+    StatisticsInterface midi(serial);
+    midi.begin(MIDI_CHANNEL_OMNI);
+    midi.turnThruOff();
+
+    session.start();
+    const unsigned count = midi.read(&stream[0], unsigned(stream.size()));
+    session.stop(stream.size(), count);
+    session.consume(midi.getStatistics().getMessages());
+}
+
+END_UNNAMED_NAMESPACE
@@ -0,0 +1,200 @@
+#include "benchmarks.h"
+#include "benchmarks_Traffic.h"
+#include <src/MIDI.h>
+#include <test/mocks/test-mocks_SerialMock.h>
+
+BEGIN_UNNAMED_NAMESPACE
+
+USING_NAMESPACE_BENCHMARKS
+
+// Reference suite: bytes go through SerialMock and read(), as they would
+// through a UART, in chunks the size of the Arduino serial receive buffer.
+
+typedef test_mocks::SerialMock<256> SerialMock;
+
+static const unsigned sChunkSize    = 64;
+static const unsigned sStreamSize   = 600000;
+static const unsigned sRoundTrips   = 100000;
+
+template<bool OneByteParsing, bool RunningStatus>
+struct SuiteSettings : midi::DefaultSettings
+{
+    static const bool Use1ByteParsing = OneByteParsing;
+    static const bool UseRunningStatus = RunningStatus;
+    static const unsigned SysExMaxSize = 1024;
+};
+
+typedef SuiteSettings<true,  false> OneByte;
+typedef SuiteSettings<false, false> MultiByte;
+typedef SuiteSettings<true,  true>  OneByteRunningStatus;
+typedef SuiteSettings<false, true>  MultiByteRunningStatus;
+
+// -----------------------------------------------------------------------------
+
+/*! NoteOn and NoteOff pairs, each with its status byte. */
+const Stream& getNoteOn()
+{
+    static Stream stream;
+    if (stream.empty())
+    {
+        Random random;
+        while (stream.size() < sStreamSize)
+        {
+            const byte note = random.data();
+            const byte pushed[6] = { 0x90, note, 100, 0x80, note, 64 };
+            stream.insert(stream.end(), pushed, pushed + 6);
+        }
+    }
+    return stream;
+}
+
+/*! Runs of 16 ControlChange messages sharing their status byte. */
+const Stream& getRunningStatus()
+{
+    static Stream stream;
+    if (stream.empty())
+    {
+        Random random;
+        while (stream.size() < sStreamSize)
+        {
+            stream.push_back(byte(midi::ControlChange | random.below(16)));
+            for (unsigned i = 0; i < 16; ++i)
+            {
+                stream.push_back(random.data());
+                stream.push_back(random.data());
+            }
+        }
+    }
+    return stream;
+}
+
+/*! SysEx frames of Size bytes, boundaries included. */
+template<unsigned Size>
+const Stream& getSysEx()
+{
+    static Stream stream;
+    if (stream.empty())
+    {
+        Random random;
+        while (stream.size() < sStreamSize)
+        {
+            stream.push_back(midi::SystemExclusive);
+            for (unsigned i = 2; i < Size; ++i)
+            {
+                stream.push_back(random.data());
+            }
+            stream.push_back(0xf7);
+        }
+    }
+    return stream;
+}
+
+/*! The NoteOn stream, with a Clock inside every message. */
+const Stream& getRealTime()
+{
+    static Stream stream;
+    if (stream.empty())
+    {
+        const Stream& notes = getNoteOn();
+        for (unsigned i = 0; i < notes.size(); i += 3)
+        {
+            const byte pushed[4] = { notes[i], notes[i + 1], midi::Clock, notes[i + 2] };
+            stream.insert(stream.end(), pushed, pushed + 4);
+        }
+    }
+    return stream;
+}
+
+// -----------------------------------------------------------------------------
+
+template<const Stream& (*GetStream)(), class Settings, bool Thru>
+void measureThroughput(Session& session)
+{
+    const Stream& stream = GetStream();
+    SerialMock serial;
+    midi::MidiInterface<SerialMock, Settings> midi(serial);
+    midi.begin(MIDI_CHANNEL_OMNI);
+    if (!Thru)
+    {
+        midi.turnThruOff();
+    }
+
+    // Thru output wraps around the transmit buffer, nobody reads it.
+    session.start();
+    uint64_t count = 0;
+    for (unsigned offset = 0; offset < stream.size(); offset += sChunkSize)
+    {
+        const unsigned size = unsigned(stream.size()) - offset < sChunkSize
+                            ? unsigned(stream.size()) - offset : sChunkSize;
+        serial.mRxBuffer.write(&stream[offset], int(size));
+        while (serial.available() > 0)
+        {
+            if (midi.read())
+            {
+                count++;
+            }
+        }
+    }
+    session.stop(stream.size(), count);
+}
+
+/*! Same as examples/Bench: send a NoteOn, loop it back and read it. */
+template<class Settings>
+void measureRoundTrip(Session& session)
+{
+    SerialMock serial;
+    midi::MidiInterface<SerialMock, Settings> midi(serial);
+    midi.begin(MIDI_CHANNEL_OMNI);
+    midi.turnThruOff();
+
+    session.start();
+    uint64_t bytes = 0;
+    for (unsigned i = 0; i < sRoundTrips; ++i)
+    {
+        midi.sendNoteOn(69, 127, 1);
+        while (!serial.mTxBuffer.isEmpty())
+        {
+            serial.mRxBuffer.write(serial.mTxBuffer.read());
+            bytes++;
+        }
+        while (!midi.read())
+        {
+        }
+    }
+    session.stop(bytes, sRoundTrips);
+}
+
+// -----------------------------------------------------------------------------
+
+#define THROUGHPUT_BENCHMARK(Name, GetStream, Settings, Thru, Suffix)                  \
+    Registration Name##_##Settings##_##Thru(                                        \
+        "Throughput", #Name Suffix, measureThroughput<GetStream, Settings, Thru>);
+
+#define THROUGHPUT_BENCHMARKS(Name, GetStream)                                                  \
+    THROUGHPUT_BENCHMARK(Name, GetStream, OneByte,                  false,  ".1byte")           \
+    THROUGHPUT_BENCHMARK(Name, GetStream, MultiByte,                false,  ".multiByte")       \
+    THROUGHPUT_BENCHMARK(Name, GetStream, OneByte,                  true,   ".1byte.thru")      \
+    THROUGHPUT_BENCHMARK(Name, GetStream, MultiByte,                true,   ".multiByte.thru")  \
+    THROUGHPUT_BENCHMARK(Name, GetStream, OneByteRunningStatus,     true,   ".1byte.thruRS")    \
+    THROUGHPUT_BENCHMARK(Name, GetStream, MultiByteRunningStatus,   true,   ".multiByte.thruRS")
+
+THROUGHPUT_BENCHMARKS(noteOn,           getNoteOn)
+THROUGHPUT_BENCHMARKS(runningStatus,    getRunningStatus)
+THROUGHPUT_BENCHMARKS(sysEx16,          getSysEx<16>)
+THROUGHPUT_BENCHMARKS(sysEx128,         getSysEx<128>)
+THROUGHPUT_BENCHMARKS(sysEx1024,        getSysEx<1024>)
+THROUGHPUT_BENCHMARKS(realTime,         getRealTime)
+
+#undef THROUGHPUT_BENCHMARKS
+#undef THROUGHPUT_BENCHMARK
+
+Registration roundTripOneByte(
+    "Latency", "noteOnRoundTrip.1byte",         measureRoundTrip<OneByte>);
+Registration roundTripMultiByte(
+    "Latency", "noteOnRoundTrip.multiByte",     measureRoundTrip<MultiByte>);
+Registration roundTripOneByteRS(
+    "Latency", "noteOnRoundTrip.1byte.RS",      measureRoundTrip<OneByteRunningStatus>);
+Registration roundTripMultiByteRS(
+    "Latency", "noteOnRoundTrip.multiByte.RS",  measureRoundTrip<MultiByteRunningStatus>);
+
+END_UNNAMED_NAMESPACE
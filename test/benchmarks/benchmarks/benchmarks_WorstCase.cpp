@@ -0,0 +1,212 @@
+#include "benchmarks.h"
+#include "benchmarks_Traffic.h"
+#include <src/MIDI.h>
+#include <test/mocks/test-mocks_SerialMock.h>
+#include <algorithm>
+
+BEGIN_UNNAMED_NAMESPACE
+
+USING_NAMESPACE_BENCHMARKS
+
+// Distribution of the time spent in each read() call, on regular traffic
+// and on a byte pattern searched to make read() as slow as possible.
+// The bounds the library commits to are documented on MidiInterface::read()
+// and checked by unit-tests_ParserBounds.cpp.
+
+typedef test_mocks::SerialMock<256> SerialMock;
+typedef std::vector<uint64_t> Samples;
+
+static const unsigned sChunkSize        = 64;
+static const unsigned sStreamSize       = 200000;
+static const unsigned sPatternSize      = 64;
+static const unsigned sSearchSize       = 8192;
+static const unsigned sSearchRounds     = 400;
+
+template<bool OneByteParsing>
+struct WorstCaseSettings : midi::DefaultSettings
+{
+    static const bool Use1ByteParsing = OneByteParsing;
+    static const unsigned SysExMaxSize = 32;
+};
+
+typedef WorstCaseSettings<true>  OneByte;
+typedef WorstCaseSettings<false> MultiByte;
+
+// -----------------------------------------------------------------------------
+
+/*! Time every read() call, Thru enabled, feeding the port chunk by chunk.
+ \return The number of messages read.
+ */
+template<class Settings>
+unsigned timeCalls(const Stream& inStream, Samples& outCalls, Samples& outPerByte)
+{
+    SerialMock serial;
+    midi::MidiInterface<SerialMock, Settings> midi(serial);
+    midi.begin(MIDI_CHANNEL_OMNI);
+
+    // Touch the samples first, page faults would show up as the worst case.
+    outCalls.assign(inStream.size(), 0);
+    outPerByte.assign(inStream.size(), 0);
+
+    unsigned calls = 0;
+    unsigned messages = 0;
+    for (unsigned offset = 0; offset < inStream.size(); offset += sChunkSize)
+    {
+        const unsigned size = std::min(sChunkSize, unsigned(inStream.size()) - offset);
+        serial.mRxBuffer.write(&inStream[offset], int(size));
+
+        int available = serial.available();
+        while (available > 0)
+        {
+            const uint64_t start = getCycleStamp();
+            const bool received = midi.read();
+            const uint64_t cycles = getCycleStamp() - start;
+
+            const int remaining = serial.available();
+            outCalls[calls]   = cycles;
+            outPerByte[calls] = cycles / uint64_t(std::max(available - remaining, 1));
+            available = remaining;
+            messages += received ? 1 : 0;
+            calls++;
+        }
+    }
+    outCalls.resize(calls);
+    outPerByte.resize(calls);
+    return messages;
+}
+
+uint64_t getPercentile(Samples& ioSamples, unsigned inPercent)
+{
+    if (ioSamples.empty())
+    {
+        return 0;
+    }
+    const size_t index = (ioSamples.size() - 1) * inPercent / 100;
+    std::nth_element(ioSamples.begin(), ioSamples.begin() + index, ioSamples.end());
+    return ioSamples[index];
+}
+
+Stream repeatPattern(const Stream& inPattern, unsigned inSize)
+{
+    Stream stream;
+    stream.reserve(inSize + inPattern.size());
+    while (stream.size() < inSize)
+    {
+        stream.insert(stream.end(), inPattern.begin(), inPattern.end());
+    }
+    return stream;
+}
+
+/*! Bytes that take the parser's data-dependent paths. */
+byte getInterestingByte(Random& inRandom)
+{
+    static const byte statuses[] = {
+        0x90, 0xb0, 0xc0, 0xe0,                 // Channel messages
+        0xf0, 0xf7, 0xf1, 0xf2, 0xf6,           // SysEx, EOX, System Common
+        0xf4, 0xf9,                             // Undefined
+        0xf8, 0xfe,                             // Real Time
+    };
+    if (inRandom.below(2) == 0)
+    {
+        return inRandom.data();
+    }
+    return statuses[inRandom.below(sizeof(statuses))];
+}
+
+/*! Hill-climb on a repeated pattern to maximise the 99th percentile of the
+ cycles per read() call. Done once, outside of the measured runs.
+ */
+template<class Settings>
+const Stream& getAdversarialTraffic()
+{
+    static Stream stream;
+    if (stream.empty())
+    {
+        Random random;
+        Samples calls;
+        Samples perByte;
+
+        Stream pattern(sPatternSize);
+        for (unsigned i = 0; i < sPatternSize; ++i)
+        {
+            pattern[i] = getInterestingByte(random);
+        }
+        timeCalls<Settings>(repeatPattern(pattern, sSearchSize), calls, perByte);
+        uint64_t bestScore = getPercentile(calls, 99);
+
+        for (unsigned round = 0; round < sSearchRounds; ++round)
+        {
+            Stream candidate = pattern;
+            if (random.below(4) == 0)
+            {
+                // Runs of data bytes reach long SysEx and Running Status
+                // paths, that single byte changes hardly ever build.
+                const unsigned length = 2 + random.below(sPatternSize / 2);
+                const unsigned start  = random.below(sPatternSize - length);
+                for (unsigned i = start; i < start + length; ++i)
+                {
+                    candidate[i] = random.data();
+                }
+                if (random.below(2) == 0)
+                {
+                    candidate[start] = midi::SystemExclusive;
+                    candidate[start + length - 1] = 0xf7;
+                }
+            }
+            for (unsigned n = 1 + random.below(4); n > 0; --n)
+            {
+                candidate[random.below(sPatternSize)] = getInterestingByte(random);
+            }
+            timeCalls<Settings>(repeatPattern(candidate, sSearchSize), calls, perByte);
+            const uint64_t score = getPercentile(calls, 99);
+            if (score > bestScore)
+            {
+                pattern.swap(candidate);
+                bestScore = score;
+            }
+        }
+        stream = repeatPattern(pattern, sStreamSize);
+    }
+    return stream;
+}
+
+const Stream& getMixedTraffic()
+{
+    static Stream stream;
+    if (stream.empty())
+    {
+        Random random;
+        appendMixedTraffic(stream, sStreamSize / 3, random);
+    }
+    return stream;
+}
+
+// -----------------------------------------------------------------------------
+
+template<const Stream& (*GetStream)(), class Settings>
+void measureWorstCase(Session& session)
+{
+    const Stream& stream = GetStream();
+    Samples calls;
+    Samples perByte;
+
+    session.start();
+    const unsigned messages = timeCalls<Settings>(stream, calls, perByte);
+    session.stop(stream.size(), messages);
+
+    session.report("p50 cycles per read()", getPercentile(calls, 50));
+    session.report("p99 cycles per read()", getPercentile(calls, 99));
+    session.report("max cycles per read()", getPercentile(calls, 100));
+    session.report("max cycles per byte",   getPercentile(perByte, 100));
+}
+
+Registration mixedOneByte(
+    "WorstCase", "mixedTraffic.1byte",      measureWorstCase<getMixedTraffic, OneByte>);
+Registration mixedMultiByte(
+    "WorstCase", "mixedTraffic.multiByte",  measureWorstCase<getMixedTraffic, MultiByte>);
+Registration adversarialOneByte(
+    "WorstCase", "adversarial.1byte",       measureWorstCase<getAdversarialTraffic<OneByte>, OneByte>);
+Registration adversarialMultiByte(
+    "WorstCase", "adversarial.multiByte",   measureWorstCase<getAdversarialTraffic<MultiByte>, MultiByte>);
+
+END_UNNAMED_NAMESPACE
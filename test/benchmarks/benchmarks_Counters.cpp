@@ -0,0 +1,187 @@
+#include "benchmarks_Counters.h"
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCHMARKS_HAS_TSC 1
+#else
+#define BENCHMARKS_HAS_TSC 0
+#endif
+
+BEGIN_BENCHMARKS_NAMESPACE
+
+BEGIN_UNNAMED_NAMESPACE
+
+int openCounter(uint32_t inType, uint64_t inConfig)
+{
+#if defined(__linux__)
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size           = sizeof(attr);
+    attr.type           = inType;
+    attr.config         = inConfig;
+    attr.disabled       = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+    return int(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+#else
+    (void)inType;
+    (void)inConfig;
+    return -1;
+#endif
+}
+
+void enableCounter(int inFd)
+{
+#if defined(__linux__)
+    if (inFd >= 0)
+    {
+        ioctl(inFd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(inFd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#else
+    (void)inFd;
+#endif
+}
+
+uint64_t disableCounter(int inFd)
+{
+    uint64_t value = 0;
+#if defined(__linux__)
+    if (inFd >= 0)
+    {
+        ioctl(inFd, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(inFd, &value, sizeof(value)) != sizeof(value))
+        {
+            value = 0;
+        }
+    }
+#else
+    (void)inFd;
+#endif
+    return value;
+}
+
+uint64_t readTsc()
+{
+#if BENCHMARKS_HAS_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+END_UNNAMED_NAMESPACE
+
+// -----------------------------------------------------------------------------
+
+uint64_t getMonotonicNanoseconds()
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return uint64_t(now.tv_sec) * 1000000000ull + uint64_t(now.tv_nsec);
+}
+
+uint64_t getCycleStamp()
+{
+    return BENCHMARKS_HAS_TSC ? readTsc() : getMonotonicNanoseconds();
+}
+
+// -----------------------------------------------------------------------------
+
+Counters::Counters()
+    : mCyclesFd(-1)
+    , mBranchMissesFd(-1)
+    , mCycles(0)
+    , mBranchMisses(0)
+    , mNanoseconds(0)
+    , mStartTsc(0)
+    , mStartTime(0)
+{
+#if defined(__linux__)
+    mCyclesFd       = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    mBranchMissesFd = openCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+#endif
+}
+
+Counters::~Counters()
+{
+    if (mCyclesFd >= 0)
+    {
+        close(mCyclesFd);
+    }
+    if (mBranchMissesFd >= 0)
+    {
+        close(mBranchMissesFd);
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+void Counters::start()
+{
+    enableCounter(mBranchMissesFd);
+    enableCounter(mCyclesFd);
+    mStartTime = getMonotonicNanoseconds();
+    mStartTsc  = readTsc();
+}
+
+void Counters::stop()
+{
+    const uint64_t stopTsc  = readTsc();
+    const uint64_t stopTime = getMonotonicNanoseconds();
+    mCycles       = disableCounter(mCyclesFd);
+    mBranchMisses = disableCounter(mBranchMissesFd);
+    mNanoseconds  = stopTime - mStartTime;
+
+    if (mCyclesFd < 0)
+    {
+        mCycles = stopTsc - mStartTsc;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+bool Counters::hasCycles() const
+{
+    return mCyclesFd >= 0 || BENCHMARKS_HAS_TSC;
+}
+
+bool Counters::hasBranchMisses() const
+{
+    return mBranchMissesFd >= 0;
+}
+
+const char* Counters::getCyclesSource() const
+{
+    if (mCyclesFd >= 0)
+    {
+        return "perf cpu-cycles";
+    }
+    return BENCHMARKS_HAS_TSC ? "time stamp counter" : "none";
+}
+
+uint64_t Counters::getCycles() const
+{
+    return mCycles;
+}
+
+uint64_t Counters::getBranchMisses() const
+{
+    return mBranchMisses;
+}
+
+uint64_t Counters::getNanoseconds() const
+{
+    return mNanoseconds;
+}
+
+END_BENCHMARKS_NAMESPACE
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "benchmarks_Namespace.h"
+#include <inttypes.h>
+
+BEGIN_BENCHMARKS_NAMESPACE
+
+/*! Hardware event counters for the calling thread.
+
+ Uses Linux perf events when the kernel lets us open them, and falls back on
+ the time stamp counter (x86) for cycles. Branch misses are only available
+ through perf events.
+ */
+class Counters
+{
+public:
+     Counters();
+    ~Counters();
+
+public:
+    void start();
+    void stop();
+
+public:
+    bool hasCycles() const;
+    bool hasBranchMisses() const;
+    const char* getCyclesSource() const;
+
+    uint64_t getCycles() const;
+    uint64_t getBranchMisses() const;
+    uint64_t getNanoseconds() const;
+
+private:
+    Counters(const Counters&);
+    Counters& operator=(const Counters&);
+
+private:
+    int mCyclesFd;
+    int mBranchMissesFd;
+    uint64_t mCycles;
+    uint64_t mBranchMisses;
+    uint64_t mNanoseconds;
+    uint64_t mStartTsc;
+    uint64_t mStartTime;
+};
+
+uint64_t getMonotonicNanoseconds();
+
+/*! Cycles from the time stamp counter, or nanoseconds where there is none.
+ Cheap enough to time a single call, unlike Counters.
+ */
+uint64_t getCycleStamp();
+
+END_BENCHMARKS_NAMESPACE
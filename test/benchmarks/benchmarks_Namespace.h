@@ -0,0 +1,13 @@
+#pragma once
+
+#define BENCHMARKS_NAMESPACE                benchmarks
+#define BEGIN_BENCHMARKS_NAMESPACE          namespace BENCHMARKS_NAMESPACE {
+#define END_BENCHMARKS_NAMESPACE            }
+#define BEGIN_UNNAMED_NAMESPACE             namespace {
+#define END_UNNAMED_NAMESPACE               }
+
+#define USING_NAMESPACE_BENCHMARKS          using namespace BENCHMARKS_NAMESPACE;
+
+BEGIN_BENCHMARKS_NAMESPACE
+
+END_BENCHMARKS_NAMESPACE
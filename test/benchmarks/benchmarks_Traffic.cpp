@@ -0,0 +1,92 @@
+#include "benchmarks_Traffic.h"
+
+BEGIN_BENCHMARKS_NAMESPACE
+
+Random::Random(uint32_t inSeed)
+    : mState(inSeed)
+{
+}
+
+uint32_t Random::next()
+{
+    // xorshift32
+    mState ^= mState << 13;
+    mState ^= mState >> 17;
+    mState ^= mState << 5;
+    return mState;
+}
+
+byte Random::data()
+{
+    return byte(next() & 0x7f);
+}
+
+unsigned Random::below(unsigned inMax)
+{
+    return next() % inMax;
+}
+
+// -----------------------------------------------------------------------------
+
+unsigned appendMixedTraffic(Stream& outStream, unsigned inMessageCount, Random& inRandom)
+{
+    static const byte sChannelTypes[] = {
+        midi::NoteOn, midi::NoteOn, midi::NoteOn, midi::NoteOff,
+        midi::ControlChange, midi::ControlChange, midi::PitchBend,
+        midi::ProgramChange, midi::AfterTouchChannel, midi::AfterTouchPoly,
+    };
+    static const unsigned sNumChannelTypes = sizeof(sChannelTypes);
+
+    byte runningStatus = 0;
+    unsigned count = 0;
+    while (count < inMessageCount)
+    {
+        const unsigned kind = inRandom.below(100);
+        if (kind < 8)
+        {
+            outStream.push_back(midi::Clock);
+        }
+        else if (kind < 10)
+        {
+            const unsigned length = 4 + inRandom.below(24);
+            outStream.push_back(midi::SystemExclusive);
+            for (unsigned i = 0; i < length; ++i)
+            {
+                outStream.push_back(inRandom.data());
+            }
+            outStream.push_back(0xf7);
+            runningStatus = 0;
+        }
+        else
+        {
+            byte status = runningStatus;
+            if (status == 0 || inRandom.below(2) == 0)
+            {
+                status = sChannelTypes[inRandom.below(sNumChannelTypes)] | inRandom.below(16);
+            }
+            if (status != runningStatus)
+            {
+                outStream.push_back(status);
+                runningStatus = status;
+            }
+            outStream.push_back(inRandom.data());
+
+            // Interleave a clock within the message from time to time
+            if (inRandom.below(32) == 0)
+            {
+                outStream.push_back(midi::Clock);
+                count++;
+            }
+
+            const byte type = status & 0xf0;
+            if (type != midi::ProgramChange && type != midi::AfterTouchChannel)
+            {
+                outStream.push_back(inRandom.data());
+            }
+        }
+        count++;
+    }
+    return count;
+}
+
+END_BENCHMARKS_NAMESPACE
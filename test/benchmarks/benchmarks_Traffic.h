@@ -0,0 +1,33 @@
+#pragma once
+
+#include "benchmarks_Namespace.h"
+#include <src/midi_Defs.h>
+#include <inttypes.h>
+#include <vector>
+
+BEGIN_BENCHMARKS_NAMESPACE
+
+typedef std::vector<byte> Stream;
+
+/*! Deterministic pseudo-random generator, so runs are comparable */
+class Random
+{
+public:
+    explicit Random(uint32_t inSeed = 0x4d494449);
+
+public:
+    uint32_t next();
+    byte data();
+    unsigned below(unsigned inMax);
+
+private:
+    uint32_t mState;
+};
+
+/*! Append a mix of channel voice messages (partly using running status),
+ interleaved clocks and short SysEx frames, as seen on a busy DIN port.
+ \return The number of messages appended.
+ */
+unsigned appendMixedTraffic(Stream& outStream, unsigned inMessageCount, Random& inRandom);
+
+END_BENCHMARKS_NAMESPACE
@@ -45,6 +45,7 @@ public: // Arduino Serial API
     void begin(int inBaudrate);
     int available() const;
     void write(uint8 inData);
+    void write(const uint8* inData, unsigned inSize);
     uint8 read();
 
 public: // Test Helpers API
@@ -55,6 +56,7 @@ public:
     Buffer mTxBuffer;
     Buffer mRxBuffer;
     int mBaudrate;
+    int mWriteCalls;
 };
 
 END_TEST_MOCKS_NAMESPACE
@@ -101,6 +101,8 @@ void RingBuffer<DataType, Size>::read(DataType* outData, int inSize)
 
 template<int BufferSize>
 SerialMock<BufferSize>::SerialMock()
+    : mBaudrate(0)
+    , mWriteCalls(0)
 {
 }
 
@@ -129,6 +131,14 @@ template<int BufferSize>
 void SerialMock<BufferSize>::write(uint8 inData)
 {
     mTxBuffer.write(inData);
+    mWriteCalls++;
+}
+
+template<int BufferSize>
+void SerialMock<BufferSize>::write(const uint8* inData, unsigned inSize)
+{
+    mTxBuffer.write(inData, int(inSize));
+    mWriteCalls++;
 }
 
 template<int BufferSize>
@@ -2,6 +2,7 @@
 #include "unit-tests_Settings.h"
 #include <src/MIDI.h>
 #include <test/mocks/test-mocks_SerialMock.h>
+#include <thread>
 
 BEGIN_MIDI_NAMESPACE
 
@@ -22,6 +23,77 @@ struct VariableSysExSettings : midi::DefaultSettings
     static const unsigned SysExMaxSize = Size;
 };
 
+template<unsigned Size>
+struct MultiByteSysExSettings : VariableSysExSettings<Size>
+{
+    static const bool Use1ByteParsing = false;
+};
+
+std::vector<byte> sysExChunks;
+std::vector<byte> sysExChunkFlags;
+
+void handleSysExChunk(byte* inData, unsigned inSize, byte inFlags)
+{
+    sysExChunks.insert(sysExChunks.end(), inData, inData + inSize);
+    sysExChunkFlags.push_back(inFlags);
+}
+
+template<unsigned Size>
+struct QueueSettings : VariableSysExSettings<8>
+{
+    static const unsigned MessageQueueSize = Size;
+};
+
+struct RealTimeFastPathSettings : QueueSettings<4>
+{
+    static const bool UseRealTimeFastPath = true;
+};
+
+std::vector<byte> receivedTypes;
+
+void handleClockEvent()
+{
+    receivedTypes.push_back(midi::Clock);
+}
+
+void handleNoteOnEvent(byte, byte, byte)
+{
+    receivedTypes.push_back(midi::NoteOn);
+}
+
+struct SteppingPlatform
+{
+    static unsigned long now()
+    {
+        return sTime += 10;
+    }
+    static unsigned long sTime;
+};
+unsigned long SteppingPlatform::sTime = 0;
+
+template<unsigned Size>
+struct TimestampSettings : QueueSettings<Size>
+{
+    static const bool UseReceiveTimestamps = true;
+};
+
+struct ManualPlatform
+{
+    static unsigned long now()
+    {
+        return sTime;
+    }
+    static unsigned long sTime;
+};
+unsigned long ManualPlatform::sTime = 0;
+
+std::vector<unsigned long> receivedTimestamps;
+
+void handleTimestampedMessage(const midi::Message<8, true>& inMessage)
+{
+    receivedTimestamps.push_back(inMessage.timestamp);
+}
+
 TEST(MidiInput, getTypeFromStatusByte)
 {
     // Channel Messages
@@ -57,6 +129,42 @@ TEST(MidiInput, getTypeFromStatusByte)
     EXPECT_EQ(MidiInterface::getTypeFromStatusByte(0xfd), midi::InvalidType);
 }
 
+TEST(MidiInput, statusTable)
+{
+    typedef midi::StatusTable Table;
+
+    for (int i = 0; i < 0x80; ++i)
+    {
+        EXPECT_EQ(Table::getFlags(i), 0);
+    }
+    for (int i = 0x80; i < 0xf0; ++i)
+    {
+        const byte type = i & 0xf0;
+        const byte length = (type == midi::ProgramChange ||
+                             type == midi::AfterTouchChannel) ? 2 : 3;
+        EXPECT_EQ(Table::getLength(i),          length);
+        EXPECT_EQ(Table::isDefined(i),          true);
+        EXPECT_EQ(Table::isChannelMessage(i),   true);
+        EXPECT_EQ(Table::isRealTime(i),         false);
+    }
+
+    static const byte systemLengths[16] = {
+        0, 2, 3, 2, 0, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1
+    };
+    for (int i = 0xf0; i < 0x100; ++i)
+    {
+        EXPECT_EQ(Table::getLength(i),          systemLengths[i & 0x0f]);
+        EXPECT_EQ(Table::isChannelMessage(i),   false);
+        EXPECT_EQ(Table::isRealTime(i),         i >= 0xf8 && Table::isDefined(i));
+    }
+    EXPECT_EQ(Table::isDefined(0xf0), true);
+    EXPECT_EQ(Table::isDefined(0xf4), false);
+    EXPECT_EQ(Table::isDefined(0xf5), false);
+    EXPECT_EQ(Table::isDefined(0xf7), false);
+    EXPECT_EQ(Table::isDefined(0xf9), false);
+    EXPECT_EQ(Table::isDefined(0xfd), false);
+}
+
 TEST(MidiInput, getChannelFromStatusByte)
 {
     EXPECT_EQ(MidiInterface::getChannelFromStatusByte(0x00), 1);
@@ -925,4 +1033,649 @@ TEST(MidiInput, strayUndefinedMultiByteParsing)
     EXPECT_EQ(midi.getData2(),      34);
 }
 
+TEST(MidiInput, multiByteParsingSysExMaxSize)
+{
+    // The whole frame is parsed by a single call, without recursion.
+    typedef MultiByteSysExSettings<1024> Settings;
+    typedef test_mocks::SerialMock<2048> LargerSerialMock;
+    typedef midi::MidiInterface<LargerSerialMock, Settings> MultiByteMidiInterface;
+
+    LargerSerialMock serial;
+    MultiByteMidiInterface midi(serial);
+
+    const unsigned sysExMaxSize = Settings::SysExMaxSize;
+    std::vector<byte> frame(sysExMaxSize);
+    frame.front() = 0xf0;
+    for (unsigned i = 1; i < frame.size() - 1; ++i)
+    {
+        frame[i] = i & 0x7f;
+    }
+    frame.back() = 0xf7;
+
+    midi.begin();
+    midi.turnThruOff();
+    serial.mRxBuffer.write(&frame[0], int(frame.size()));
+    EXPECT_EQ(midi.read(), true);
+    EXPECT_EQ(serial.mRxBuffer.getLength(), 0);
+    EXPECT_EQ(midi.getType(), midi::SystemExclusive);
+    EXPECT_EQ(midi.getSysExArrayLength(), sysExMaxSize);
+    const std::vector<byte> sysExData(midi.getSysExArray(),
+                                      midi.getSysExArray() + frame.size());
+    EXPECT_THAT(sysExData, ContainerEq(frame));
+}
+
+TEST(MidiInput, multiByteParsingRecoversFromErrors)
+{
+    typedef VariableSettings<false, false> Settings;
+    typedef midi::MidiInterface<SerialMock, Settings> MultiByteMidiInterface;
+
+    SerialMock serial;
+    MultiByteMidiInterface midi(serial);
+
+    static const unsigned rxSize = 7;
+    static const byte rxData[rxSize] = {
+        0xf4, 0xf7, 12,     // Invalid data, dropped
+        0x9b, 12, 34,
+        0xf8
+    };
+    midi.begin(12);
+    serial.mRxBuffer.write(rxData, rxSize);
+    EXPECT_EQ(midi.read(), true);
+    EXPECT_EQ(midi.getType(),       midi::NoteOn);
+    EXPECT_EQ(midi.getData1(),      12);
+    EXPECT_EQ(midi.getData2(),      34);
+    EXPECT_EQ(serial.mRxBuffer.getLength(), 1);
+    EXPECT_EQ(midi.read(), true);
+    EXPECT_EQ(midi.getType(),       midi::Clock);
+    EXPECT_EQ(midi.read(), false);
+}
+
+TEST(MidiInput, bufferParsing)
+{
+    SerialMock serial;
+    MidiInterface midi(serial);
+    static const unsigned rxSize = 12;
+    static const byte rxData[rxSize] = {
+        0x9b, 12, 34,
+              56, 78,   // Running status
+        0xf8,
+        0x9c, 12, 34,   // Other channel
+        0xbb, 12, 34,
+    };
+    midi.begin(12);
+    midi.turnThruOff();
+
+    EXPECT_EQ(midi.read(rxData, rxSize), unsigned(4));
+    EXPECT_EQ(serial.mRxBuffer.getLength(), 0);
+
+    // Last message is left in the structure
+    EXPECT_EQ(midi.getType(),       midi::ControlChange);
+    EXPECT_EQ(midi.getChannel(),    12);
+    EXPECT_EQ(midi.getData1(),      12);
+    EXPECT_EQ(midi.getData2(),      34);
+}
+
+TEST(MidiInput, bufferParsingSplitMessage)
+{
+    SerialMock serial;
+    MidiInterface midi(serial);
+    static const byte rxData[5] = { 0x9b, 12, 34, 0x8b, 56 };
+    static const byte rxTail[1] = { 78 };
+    midi.begin(12);
+
+    EXPECT_EQ(midi.read(rxData, 5), unsigned(1));
+    EXPECT_EQ(midi.getType(),       midi::NoteOn);
+
+    // Pending NoteOff can be completed either by a buffer or by the port
+    serial.mRxBuffer.write(rxTail, 1);
+    EXPECT_EQ(midi.read(), true);
+    EXPECT_EQ(midi.getType(),       midi::NoteOff);
+    EXPECT_EQ(midi.getData1(),      56);
+    EXPECT_EQ(midi.getData2(),      78);
+
+    EXPECT_EQ(midi.read(rxTail, 0), unsigned(0));
+}
+
+TEST(MidiInput, bufferParsingInputDisabled)
+{
+    SerialMock serial;
+    MidiInterface midi(serial);
+    static const byte rxData[3] = { 0x9b, 12, 34 };
+    midi.begin(MIDI_CHANNEL_OFF);
+    EXPECT_EQ(midi.read(rxData, 3), unsigned(0));
+    EXPECT_EQ(midi.getType(),       midi::InvalidType);
+}
+
+TEST(MidiInput, sysExChunks)
+{
+    typedef VariableSysExSettings<4> Settings;
+    typedef midi::MidiInterface<SerialMock, Settings> ChunkMidiInterface;
+    SerialMock serial;
+    ChunkMidiInterface midi(serial);
+    static const byte rxData[14] = {
+        0xf0, 1, 2, 3, 4, 5, 0xf8, 6, 7, 8, 9, 0xf7,
+        0xf0, 0xf7
+    };
+    static const byte expected[13] = {
+        0xf0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0xf7,
+        0xf0, 0xf7
+    };
+    static const byte expectedFlags[4] = {
+        midi::SysExChunk::Start,
+        midi::SysExChunk::Continue,
+        midi::SysExChunk::End,
+        midi::SysExChunk::Start | midi::SysExChunk::End
+    };
+    sysExChunks.clear();
+    sysExChunkFlags.clear();
+    midi.setHandleSystemExclusiveChunk(handleSysExChunk);
+    midi.begin(MIDI_CHANNEL_OMNI);
+
+    // Chunks are forwarded to Thru as they come
+    EXPECT_EQ(midi.read(rxData, 14), unsigned(5));
+    EXPECT_THAT(sysExChunks, ElementsAreArray(expected));
+    EXPECT_THAT(sysExChunkFlags, ElementsAreArray(expectedFlags, 4));
+    EXPECT_EQ(serial.mTxBuffer.getLength(), 14);
+
+    // A full last chunk is followed by a chunk with EOX only
+    static const byte rxFull[5] = { 0xf0, 1, 2, 3, 0xf7 };
+    sysExChunks.clear();
+    sysExChunkFlags.clear();
+    EXPECT_EQ(midi.read(rxFull, 5), unsigned(2));
+    EXPECT_THAT(sysExChunks, ElementsAreArray(rxFull));
+    EXPECT_THAT(sysExChunkFlags, ElementsAre(midi::SysExChunk::Start,
+                                             midi::SysExChunk::End));
+    EXPECT_EQ(midi.getSysExArrayLength(), unsigned(1));
+}
+
+TEST(MidiInput, readMessages)
+{
+    SerialMock serial;
+    MidiInterface midi(serial);
+    static const byte rxData[10] = { 0x9b, 12, 34, 0xf8, 56, 78, 0xbb, 12, 34, 0xf8 };
+    midi.begin(12);
+
+    serial.mRxBuffer.write(rxData, 10);
+    EXPECT_EQ(midi.readMessages(2), unsigned(2));
+    EXPECT_EQ(midi.getType(),       midi::Clock);
+    EXPECT_EQ(midi.readMessages(8), unsigned(3));
+    EXPECT_EQ(midi.getType(),       midi::Clock);
+    EXPECT_EQ(midi.readMessages(8), unsigned(0));
+
+    // Non-matching messages are counted
+    serial.mRxBuffer.write(rxData, 6);
+    EXPECT_EQ(midi.readMessages(8, 3), unsigned(3));
+    EXPECT_EQ(midi.readMessages(8, MIDI_CHANNEL_OFF), unsigned(0));
+}
+
+TEST(MidiInput, readMessagesDecodeOnly)
+{
+    SerialMock serial;
+    MidiInterface midi(serial);
+    static const byte rxData[6] = { 0x9b, 12, 34, 0xbb, 56, 78 };
+    midi.begin(12);
+
+    // Without a queue, the first message completed waits for the next call
+    serial.mRxBuffer.write(rxData, 6);
+    EXPECT_EQ(midi.readMessages(0), unsigned(0));
+    EXPECT_EQ(serial.mRxBuffer.getLength(), 3);
+    EXPECT_EQ(midi.readMessages(0), unsigned(0));
+    EXPECT_EQ(serial.mRxBuffer.getLength(), 3);
+    EXPECT_EQ(midi.read(), true);
+    EXPECT_EQ(midi.getType(), midi::NoteOn);
+    EXPECT_EQ(midi.readMessages(0), unsigned(0));
+    EXPECT_EQ(midi.readMessages(8), unsigned(1));
+    EXPECT_EQ(midi.getType(), midi::ControlChange);
+}
+
+TEST(MidiInput, readFor)
+{
+    typedef midi::MidiInterface<SerialMock, midi::DefaultSettings, SteppingPlatform> SteppingMidi;
+    SerialMock serial;
+    SteppingMidi midi(serial);
+    static const byte rxData[6] = { 0xf8, 0xfa, 0xfb, 0xfc, 0xfe, 0xf8 };
+    midi.begin(MIDI_CHANNEL_OMNI);
+
+    serial.mRxBuffer.write(rxData, 6);
+    EXPECT_EQ(midi.readFor(20), unsigned(2));   // 10us per message
+    EXPECT_EQ(midi.getType(),   midi::Start);
+    EXPECT_EQ(midi.readFor(25), unsigned(3));
+    EXPECT_EQ(midi.getType(),   midi::ActiveSensing);
+    EXPECT_EQ(midi.readFor(1000), unsigned(1));
+    EXPECT_EQ(midi.readFor(1000), unsigned(0));
+}
+
+TEST(MidiInput, messageQueue)
+{
+    typedef midi::MidiInterface<SerialMock, QueueSettings<3> > QueueMidiInterface;
+    SerialMock serial;
+    QueueMidiInterface midi(serial);
+    static const byte rxData[11] = { 0x9b, 12, 0xf8, 34, 0xbb, 56, 78, 0xc3, 1, 0xfa, 0xfc };
+    midi.begin(MIDI_CHANNEL_OMNI);
+    midi.turnThruOff();
+    serial.mRxBuffer.write(rxData, 11);
+
+    // The Clock interleaved in the NoteOn is handed over first,
+    // the NoteOn is not overwritten
+    EXPECT_EQ(midi.read(), true);
+    EXPECT_EQ(midi.getType(),       midi::Clock);
+    EXPECT_EQ(serial.mRxBuffer.getLength(), 4); // Queue full: 3 messages
+    EXPECT_EQ(midi.read(), true);
+    EXPECT_EQ(midi.getType(),       midi::NoteOn);
+    EXPECT_EQ(midi.getData1(),      12);
+    EXPECT_EQ(midi.getData2(),      34);
+    EXPECT_EQ(midi.read(), true);
+    EXPECT_EQ(midi.getType(),       midi::ControlChange);
+    EXPECT_EQ(midi.getData1(),      56);
+    EXPECT_EQ(midi.getData2(),      78);
+    EXPECT_EQ(serial.mRxBuffer.getLength(), 1);
+
+    // Remaining messages can be drained in bulk
+    EXPECT_EQ(midi.readMessages(8), unsigned(3));
+    EXPECT_EQ(midi.getType(),       midi::Stop);
+    EXPECT_EQ(midi.read(), false);
+}
+
+TEST(MidiInput, messageQueueBufferParsing)
+{
+    typedef midi::MidiInterface<SerialMock, QueueSettings<2> > QueueMidiInterface;
+    SerialMock serial;
+    QueueMidiInterface midi(serial);
+    static const byte rxQueued[3] = { 0x9b, 12, 34 };
+    static const byte rxData[9] = { 0xf8, 0xfa, 0xbb, 56, 78, 0xf0, 1, 2, 0xf7 };
+    sysExChunks.clear();
+    midi.setHandleSystemExclusiveChunk(handleSysExChunk);
+    midi.begin(MIDI_CHANNEL_OMNI);
+    midi.turnThruOff();
+
+    serial.mRxBuffer.write(rxQueued, 3);
+    EXPECT_EQ(midi.readMessages(0), unsigned(0));
+    EXPECT_EQ(serial.mRxBuffer.getLength(), 0);
+
+    // Queued messages are handled first, in order
+    EXPECT_EQ(midi.read(rxData, 9), unsigned(5));
+    EXPECT_EQ(midi.getType(),       midi::SystemExclusive);
+    EXPECT_THAT(sysExChunks, ElementsAre(0xf0, 1, 2, 0xf7));
+    EXPECT_EQ(midi.read(), false);
+}
+
+TEST(MidiInput, realTimeFastPath)
+{
+    typedef midi::MidiInterface<SerialMock, RealTimeFastPathSettings> FastMidiInterface;
+    SerialMock serial;
+    FastMidiInterface midi(serial);
+    static const byte rxData[9] = { 0x9b, 12, 34, 56, 0xf8, 78, 0xf9, 0xfa, 0xf8 };
+    static const byte txData[3] = { 0xf8, 0xfa, 0xf8 };
+    receivedTypes.clear();
+    midi.setHandleClock(handleClockEvent);
+    midi.setHandleNoteOn(handleNoteOnEvent);
+    midi.begin(MIDI_CHANNEL_OMNI);
+    midi.turnThruOn();
+    serial.mRxBuffer.write(rxData, 9);
+
+    // Clocks are handled while decoding, ahead of the queued NoteOns
+    EXPECT_EQ(midi.read(), true);
+    EXPECT_EQ(midi.getType(),       midi::NoteOn);
+    EXPECT_THAT(receivedTypes, ElementsAre(midi::Clock, midi::Clock, midi::NoteOn));
+    EXPECT_EQ(midi.readMessages(8), unsigned(1));
+    EXPECT_EQ(midi.getType(),       midi::NoteOn);
+    EXPECT_EQ(midi.getData1(),      56);
+    EXPECT_EQ(midi.getData2(),      78);
+
+    // Thru: Real Time first, undefined bytes are dropped
+    byte buffer[3] = { 0 };
+    EXPECT_EQ(serial.mTxBuffer.getLength(), 9);
+    serial.mTxBuffer.read(buffer, 3);
+    EXPECT_THAT(buffer, ElementsAreArray(txData));
+
+    // Same with buffer parsing
+    midi.turnThruOff();
+    receivedTypes.clear();
+    EXPECT_EQ(midi.read(rxData + 3, 6), unsigned(1));
+    EXPECT_THAT(receivedTypes, ElementsAre(midi::Clock, midi::Clock, midi::NoteOn));
+}
+
+TEST(MidiInput, feed)
+{
+    typedef midi::MidiInterface<SerialMock, QueueSettings<2> > QueueMidiInterface;
+    SerialMock serial;
+    QueueMidiInterface midi(serial);
+    static const byte rxData[7] = { 0x9b, 12, 34, 0xbb, 56, 78, 0xf8 };
+    midi.begin(MIDI_CHANNEL_OMNI);
+    midi.turnThruOff();
+
+    // Bytes pushed between two reads, as from an interrupt
+    EXPECT_EQ(midi.read(), false);
+    EXPECT_EQ(midi.feed(rxData[0]), true);
+    EXPECT_EQ(midi.feed(rxData[1]), true);
+    EXPECT_EQ(midi.read(), false);
+    EXPECT_EQ(midi.feed(rxData[2]), true);
+    EXPECT_EQ(midi.read(), true);
+    EXPECT_EQ(midi.getType(),       midi::NoteOn);
+    EXPECT_EQ(midi.getData2(),      34);
+
+    // Full queue: the last message is dropped
+    EXPECT_EQ(midi.feed(rxData, 7), false);
+    EXPECT_EQ(midi.readMessages(8), unsigned(2));
+    EXPECT_EQ(midi.getType(),       midi::ControlChange);
+    EXPECT_EQ(midi.read(), false);
+}
+
+TEST(MidiInput, readBufferWithFullQueue)
+{
+    typedef midi::MidiInterface<SerialMock, QueueSettings<2> > QueueMidiInterface;
+    SerialMock serial;
+    QueueMidiInterface midi(serial);
+    static const byte rxData[7] = { 0x9b, 12, 34, 0xf8, 0x9b, 56, 78 };
+    midi.begin(MIDI_CHANNEL_OMNI);
+    midi.turnThruOff();
+    midi.setHandleClock(handleClockEvent);
+    midi.setHandleNoteOn(handleNoteOnEvent);
+    receivedTypes.clear();
+
+    // The oldest queued message makes room for the new one
+    EXPECT_EQ(midi.feed(rxData, 4), true);
+    EXPECT_EQ(midi.read(rxData + 4, 3), unsigned(3));
+    EXPECT_THAT(receivedTypes, ElementsAre(midi::NoteOn, midi::Clock, midi::NoteOn));
+    EXPECT_EQ(midi.getData1(), 56);
+    EXPECT_EQ(midi.read(), false);
+}
+
+TEST(MidiInput, messageQueueSysEx)
+{
+    // SysEx payloads are queued apart from the messages
+    typedef midi::MidiInterface<SerialMock, QueueSettings<8> > QueueMidiInterface;
+    SerialMock serial;
+    QueueMidiInterface midi(serial);
+    static const byte rxData[18] = {
+        0xf0, 1, 2, 3, 4, 5, 6, 0xf7,
+        0x9b, 12, 34,
+        0xf0, 7, 8, 0xf7,
+        0xf0, 0xf7,
+        0xf8
+    };
+    midi.begin(MIDI_CHANNEL_OMNI);
+    midi.turnThruOff();
+
+    EXPECT_EQ(midi.feed(rxData, 18), true);
+    EXPECT_EQ(midi.read(), true);
+    EXPECT_EQ(midi.getType(),               midi::SystemExclusive);
+    EXPECT_EQ(midi.getSysExArrayLength(),   unsigned(8));
+    EXPECT_THAT(std::vector<byte>(midi.getSysExArray(), midi.getSysExArray() + 8),
+                ElementsAreArray(rxData, 8));
+    EXPECT_EQ(midi.read(), true);
+    EXPECT_EQ(midi.getType(),               midi::NoteOn);
+    EXPECT_EQ(midi.getChannel(),            12);
+    EXPECT_EQ(midi.read(), true);
+    EXPECT_EQ(midi.getSysExArrayLength(),   unsigned(4));
+    EXPECT_THAT(std::vector<byte>(midi.getSysExArray(), midi.getSysExArray() + 4),
+                ElementsAreArray(rxData + 11, 4));
+    EXPECT_EQ(midi.read(), true);
+    EXPECT_EQ(midi.getSysExArrayLength(),   unsigned(2));
+    EXPECT_EQ(midi.read(), true);
+    EXPECT_EQ(midi.getType(),               midi::Clock);
+    EXPECT_EQ(midi.read(), false);
+}
+
+TEST(MidiInput, feedFromInterruptThread)
+{
+    typedef midi::MidiInterface<SerialMock, QueueSettings<8> > QueueMidiInterface;
+    static const unsigned count = 20000;
+    SerialMock serial;
+    QueueMidiInterface midi(serial);
+    midi.begin(MIDI_CHANNEL_OMNI);
+    midi.turnThruOff();
+
+    std::thread interrupt([&midi]()
+    {
+        for (unsigned i = 0; i < count; ++i)
+        {
+            const byte message[3] = { 0x90, byte(i & 0x7f), byte(1 + (i >> 7) % 127) };
+
+            // A message dropped by a full queue is sent again
+            while (!midi.feed(message, 3))
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    unsigned received = 0;
+    unsigned errors = 0;
+    while (received < count)
+    {
+        if (!midi.read())
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        errors += midi.getData1() != (received & 0x7f);
+        errors += midi.getData2() != 1 + (received >> 7) % 127;
+        ++received;
+    }
+    interrupt.join();
+
+    EXPECT_EQ(errors, unsigned(0));
+    EXPECT_EQ(midi.read(), false);
+}
+
+TEST(MidiInput, feedWithoutQueue)
+{
+    SerialMock serial;
+    MidiInterface midi(serial);
+    static const byte rxData[3] = { 0x9b, 12, 34 };
+    receivedTypes.clear();
+    midi.setHandleNoteOn(handleNoteOnEvent);
+    midi.begin(12);
+    EXPECT_EQ(midi.feed(rxData, 3), true);
+    EXPECT_THAT(receivedTypes, ElementsAre(midi::NoteOn));
+    EXPECT_EQ(midi.getType(),       midi::NoteOn);
+
+    midi.setInputChannel(MIDI_CHANNEL_OFF);
+    EXPECT_EQ(midi.feed(rxData, 3), true);
+    EXPECT_THAT(receivedTypes, ElementsAre(midi::NoteOn));
+
+    // Real Time fast path: neither handled nor sent through
+    typedef midi::MidiInterface<SerialMock, RealTimeFastPathSettings> FastMidiInterface;
+    SerialMock fastSerial;
+    FastMidiInterface fastMidi(fastSerial);
+    static const byte clock = 0xf8;
+    receivedTypes.clear();
+    fastMidi.setHandleClock(handleClockEvent);
+    fastMidi.begin(MIDI_CHANNEL_OFF);
+    fastMidi.turnThruOn(midi::Thru::Full);
+    EXPECT_EQ(fastMidi.feed(&clock, 1), true);
+    EXPECT_THAT(receivedTypes, ElementsAre());
+    EXPECT_EQ(fastSerial.mTxBuffer.getLength(), 0);
+
+    fastMidi.setInputChannel(MIDI_CHANNEL_OMNI);
+    EXPECT_EQ(fastMidi.feed(&clock, 1), true);
+    EXPECT_THAT(receivedTypes, ElementsAre(midi::Clock));
+    EXPECT_EQ(fastSerial.mTxBuffer.getLength(), 1);
+}
+
+TEST(MidiInput, receiveTimestamps)
+{
+    typedef midi::MidiInterface<SerialMock, TimestampSettings<0>, ManualPlatform> TimestampMidi;
+    SerialMock serial;
+    TimestampMidi midi(serial);
+    midi.begin(MIDI_CHANNEL_OMNI);
+    midi.setHandleMessage(handleTimestampedMessage);
+    receivedTimestamps.clear();
+
+    // Time of the first byte, Running Status included
+    static const byte rxData[9] = { 0x9b, 12, 0xf8, 34, 56, 78, 0xf0, 1, 0xf7 };
+    static const unsigned long times[9] = { 100, 150, 160, 200, 300, 310, 400, 410, 420 };
+    for (unsigned i = 0; i < 9; ++i)
+    {
+        ManualPlatform::sTime = times[i];
+        midi.feed(rxData[i]);
+    }
+    EXPECT_THAT(receivedTimestamps, ElementsAre(160, 100, 300, 400));
+    EXPECT_EQ(midi.getTimestamp(), 400ul);
+}
+
+TEST(MidiInput, receiveTimestampsQueued)
+{
+    typedef midi::MidiInterface<SerialMock, TimestampSettings<4>, ManualPlatform> TimestampMidi;
+    SerialMock serial;
+    TimestampMidi midi(serial);
+    midi.begin(MIDI_CHANNEL_OMNI);
+
+    static const byte rxData[5] = { 0x9b, 12, 34, 0xc0, 5 };
+    ManualPlatform::sTime = 1000;
+    midi.feed(rxData, 3);
+    ManualPlatform::sTime = 2000;
+    midi.feed(rxData + 3, 2);
+
+    // Read later, the time of reception is kept
+    ManualPlatform::sTime = 5000;
+    EXPECT_EQ(midi.read(), true);
+    EXPECT_EQ(midi.getType(), midi::NoteOn);
+    EXPECT_EQ(midi.getTimestamp(), 1000ul);
+    EXPECT_EQ(midi.read(), true);
+    EXPECT_EQ(midi.getType(), midi::ProgramChange);
+    EXPECT_EQ(midi.getTimestamp(), 2000ul);
+}
+
+/*! Message popping the queue while it is being pushed, as the main loop
+ can when push() runs in an interrupt.
+ */
+struct InterruptedMessage : midi::Message<8, true>
+{
+    typedef midi::MessageQueue<InterruptedMessage, 4> Queue;
+
+    inline midi::ShortMessage getShortMessage() const
+    {
+        popAll();
+        return midi::Message<8, true>::getShortMessage();
+    }
+
+    inline unsigned long getTimestamp() const
+    {
+        popAll();
+        return midi::Message<8, true>::getTimestamp();
+    }
+
+    static void popAll()
+    {
+        InterruptedMessage message;
+        while (sQueue->pop(message))
+        {
+            sPopped.push_back(message.timestamp);
+        }
+    }
+
+    static Queue* sQueue;
+    static std::vector<unsigned long> sPopped;
+};
+
+InterruptedMessage::Queue* InterruptedMessage::sQueue = 0;
+std::vector<unsigned long> InterruptedMessage::sPopped;
+
+TEST(MidiInput, receiveTimestampsPoppedDuringPush)
+{
+    InterruptedMessage::Queue queue;
+    InterruptedMessage unused;
+    InterruptedMessage::sQueue = &queue;
+    InterruptedMessage::sPopped.clear();
+
+    static const unsigned long times[3] = { 100, 200, 300 };
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        InterruptedMessage& workspace = queue.getWorkspace(unused);
+        workspace.type      = midi::NoteOn;
+        workspace.channel   = 1;
+        workspace.data1     = byte(i);
+        workspace.data2     = 100;
+        workspace.valid     = true;
+        workspace.timestamp = times[i];
+        EXPECT_EQ(queue.push(), true);
+    }
+    InterruptedMessage::popAll();
+    EXPECT_THAT(InterruptedMessage::sPopped, ElementsAre(100, 200, 300));
+}
+
+/*! Message pushing to the queue while it is being popped, as an interrupt
+ can when pop() runs in the main loop.
+ */
+struct InterruptingMessage : midi::Message<8, true>
+{
+    typedef midi::MessageQueue<InterruptingMessage, 4> Queue;
+
+    inline void setShortMessage(const midi::ShortMessage& inMessage)
+    {
+        if (sQueue != 0)
+        {
+            InterruptingMessage unused;
+            InterruptingMessage& workspace = sQueue->getWorkspace(unused);
+            workspace.type      = midi::NoteOn;
+            workspace.channel   = 1;
+            workspace.data1     = 4;
+            workspace.data2     = 100;
+            workspace.valid     = true;
+            workspace.timestamp = 500;
+            sPushed.push_back(sQueue->push());
+        }
+        midi::Message<8, true>::setShortMessage(inMessage);
+    }
+
+    static Queue* sQueue;
+    static std::vector<bool> sPushed;
+};
+
+InterruptingMessage::Queue* InterruptingMessage::sQueue = 0;
+std::vector<bool> InterruptingMessage::sPushed;
+
+TEST(MidiInput, receiveTimestampsPushedDuringPop)
+{
+    InterruptingMessage::Queue queue;
+    InterruptingMessage unused;
+    InterruptingMessage::sQueue = 0;
+    InterruptingMessage::sPushed.clear();
+
+    static const unsigned long times[4] = { 100, 200, 300, 400 };
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        InterruptingMessage& workspace = queue.getWorkspace(unused);
+        workspace.type      = midi::NoteOn;
+        workspace.channel   = 1;
+        workspace.data1     = byte(i);
+        workspace.data2     = 100;
+        workspace.valid     = true;
+        workspace.timestamp = times[i];
+        EXPECT_EQ(queue.push(), true);
+    }
+
+    // The slot being popped is still taken: the interrupt finds the queue
+    // full, rather than overwriting the time that is about to be read.
+    InterruptingMessage::sQueue = &queue;
+    InterruptingMessage message;
+    EXPECT_EQ(queue.pop(message), true);
+    InterruptingMessage::sQueue = 0;
+    EXPECT_THAT(InterruptingMessage::sPushed, ElementsAre(false));
+    EXPECT_EQ(message.data1, 0);
+    EXPECT_EQ(message.timestamp, 100ul);
+
+    std::vector<unsigned long> popped;
+    while (queue.pop(message))
+    {
+        popped.push_back(message.timestamp);
+    }
+    EXPECT_THAT(popped, ElementsAre(200, 300, 400));
+}
+
+TEST(MidiInput, receiveTimestampsCompiledOut)
+{
+    EXPECT_EQ(sizeof(midi::Message<8>), sizeof(midi::Message<8, false>));
+    EXPECT_GE(sizeof(midi::Message<8, true>), sizeof(midi::Message<8>) + sizeof(unsigned long));
+
+    SerialMock serial;
+    MidiInterface midi(serial);
+    midi.begin(MIDI_CHANNEL_OMNI);
+    static const byte rxData[3] = { 0x9b, 12, 34 };
+    EXPECT_EQ(midi.read(rxData, 3), 1u);
+    EXPECT_EQ(midi.getTimestamp(), 0ul);
+}
+
 END_UNNAMED_NAMESPACE
@@ -587,4 +587,183 @@ TEST_F(MidiInputCallbacks, realTime)
     }
 }
 
+// -----------------------------------------------------------------------------
+
+class Receiver
+{
+public:
+    Receiver()
+        : mNotes(0)
+        , mClocks(0)
+        , mMessages(0)
+        , mLastType(midi::InvalidType)
+    {
+    }
+
+    void noteOn(byte, byte inNote, byte)
+    {
+        mNotes += inNote;
+    }
+
+    void clock()
+    {
+        mClocks++;
+    }
+
+    void message(const MidiInterface::MidiMessage& inMessage)
+    {
+        mMessages++;
+        mLastType = inMessage.type;
+    }
+
+public:
+    unsigned mNotes;
+    unsigned mClocks;
+    unsigned mMessages;
+    midi::MidiType mLastType;
+};
+
+TEST(MidiInputDelegates, boundToObjects)
+{
+    typedef midi::Delegate<void(byte, byte, byte)> NoteDelegate;
+    typedef midi::Delegate<void()> ClockDelegate;
+    SerialMock serial1;
+    SerialMock serial2;
+    MidiInterface midi1(serial1);
+    MidiInterface midi2(serial2);
+    Receiver receiver1;
+    Receiver receiver2;
+    midi1.setHandleNoteOn(NoteDelegate::bind<Receiver, &Receiver::noteOn>(&receiver1));
+    midi1.setHandleClock(ClockDelegate::bind<Receiver, &Receiver::clock>(&receiver1));
+    midi2.setHandleNoteOn(NoteDelegate::bind<Receiver, &Receiver::noteOn>(&receiver2));
+    midi1.begin(MIDI_CHANNEL_OMNI);
+    midi2.begin(MIDI_CHANNEL_OMNI);
+
+    static const byte rxData[] = { 0x90, 12, 34, 0xf8, 56, 78 };
+    EXPECT_EQ(midi1.read(rxData, sizeof(rxData)), unsigned(3));
+    EXPECT_EQ(midi2.read(rxData, 3), unsigned(1));
+    EXPECT_EQ(receiver1.mNotes,  unsigned(12 + 56));
+    EXPECT_EQ(receiver1.mClocks, unsigned(1));
+    EXPECT_EQ(receiver2.mNotes,  unsigned(12));
+    EXPECT_EQ(receiver2.mClocks, unsigned(0));
+
+    midi1.disconnectCallbackFromType(midi::NoteOn);
+    EXPECT_EQ(midi1.read(rxData, 3), unsigned(1));
+    EXPECT_EQ(receiver1.mNotes, unsigned(12 + 56));
+}
+
+TEST(MidiInputDelegates, messageCallback)
+{
+    typedef midi::Delegate<void(const MidiInterface::MidiMessage&)> MessageDelegate;
+    SerialMock serial;
+    MidiInterface midiInterface(serial);
+    Receiver receiver;
+    midiInterface.setHandleMessage(MessageDelegate::bind<Receiver, &Receiver::message>(&receiver));
+    midiInterface.setHandleClock(handleClock);
+    midiInterface.begin(MIDI_CHANNEL_OMNI);
+    midiInterface.turnThruOff();
+
+    // Called for every message, along with the callback of the type
+    static const byte rxData[] = { 0x90, 12, 34, 0xf8, 0xf0, 1, 2, 0xf7, 0xc3, 5 };
+    midi = &midiInterface;
+    EXPECT_EQ(midiInterface.read(rxData, sizeof(rxData)), unsigned(4));
+    midi = nullptr;
+    EXPECT_EQ(receiver.mMessages, unsigned(4));
+    EXPECT_EQ(receiver.mLastType, midi::ProgramChange);
+    EXPECT_EQ(serial.mTxBuffer.getLength(), 1);
+    EXPECT_EQ(serial.mTxBuffer.read(), 0xf8);
+}
+
+unsigned lambdaNotes = 0;
+
+TEST(MidiInputDelegates, lambdas)
+{
+    SerialMock serial;
+    MidiInterface midiInterface(serial);
+    midiInterface.setHandleNoteOn([](byte, byte inNote, byte) { lambdaNotes += inNote; });
+    midiInterface.setHandleClock([]() { lambdaNotes += 1000; });
+    midiInterface.setHandleNoteOff(0);
+    midiInterface.setHandleStop(nullptr);
+    midiInterface.begin(MIDI_CHANNEL_OMNI);
+    lambdaNotes = 0;
+
+    static const byte rxData[] = { 0x90, 12, 34, 0xf8, 0x80, 12, 0, 0xfc };
+    EXPECT_EQ(midiInterface.read(rxData, sizeof(rxData)), unsigned(4));
+    EXPECT_EQ(lambdaNotes, unsigned(1012));
+
+    const midi::Delegate<void()> unbound;
+    const midi::Delegate<void()> function([]() { lambdaNotes++; });
+    EXPECT_EQ(unbound.isBound(), false);
+    EXPECT_EQ(function.isBound(), true);
+    function();
+    EXPECT_EQ(lambdaNotes, unsigned(1013));
+}
+
+// -----------------------------------------------------------------------------
+
+std::vector<byte> staticHandlerEvents;
+
+struct RecordingHandler : public midi::StaticHandler
+{
+    static void handleNoteOn(byte inChannel, byte inNote, byte inVelocity)
+    {
+        staticHandlerEvents.push_back(midi::NoteOn);
+        staticHandlerEvents.push_back(inChannel);
+        staticHandlerEvents.push_back(inNote);
+        staticHandlerEvents.push_back(inVelocity);
+    }
+    static void handleClock()
+    {
+        staticHandlerEvents.push_back(midi::Clock);
+    }
+};
+
+struct ChunkHandler : public midi::StaticHandler
+{
+    static void handleSystemExclusiveChunk(byte* inArray, unsigned inSize, byte inFlags)
+    {
+        staticHandlerEvents.insert(staticHandlerEvents.end(), inArray, inArray + inSize);
+        staticHandlerEvents.push_back(inFlags);
+    }
+    static bool usesSysExChunks()
+    {
+        return true;
+    }
+};
+
+TEST(MidiInputStaticHandler, dispatch)
+{
+    typedef midi::MidiInterface<SerialMock, Settings, midi::DefaultPlatform, RecordingHandler> StaticMidiInterface;
+    SerialMock serial;
+    StaticMidiInterface staticMidi(serial);
+    staticMidi.begin(MIDI_CHANNEL_OMNI);
+    staticMidi.turnThruOff();
+    staticHandlerEvents.clear();
+
+    // Unhandled types are ignored
+    static const byte rxData[] = { 0x92, 12, 34, 0xf8, 0xb0, 1, 2, 34, 56 };
+    EXPECT_EQ(staticMidi.read(rxData, sizeof(rxData)), unsigned(4));
+    EXPECT_THAT(staticHandlerEvents, ElementsAre(midi::NoteOn, 3, 12, 34, midi::Clock));
+
+    // The pointers to callbacks are not stored
+    EXPECT_GE(sizeof(MidiInterface) - sizeof(StaticMidiInterface),
+              19 * sizeof(void (*)()));
+}
+
+TEST(MidiInputStaticHandler, sysExChunks)
+{
+    typedef VariableSysExSettings<4> SmallSettings;
+    typedef midi::MidiInterface<SerialMock, SmallSettings, midi::DefaultPlatform, ChunkHandler> StaticMidiInterface;
+    SerialMock serial;
+    StaticMidiInterface staticMidi(serial);
+    staticMidi.begin(MIDI_CHANNEL_OMNI);
+    staticMidi.turnThruOff();
+    staticHandlerEvents.clear();
+
+    static const byte rxData[] = { 0xf0, 1, 2, 3, 4, 0xf7 };
+    EXPECT_EQ(staticMidi.read(rxData, sizeof(rxData)), unsigned(2));
+    EXPECT_THAT(staticHandlerEvents, ElementsAre(0xf0, 1, 2, 3, midi::SysExChunk::Start,
+                                                 4, 0xf7, midi::SysExChunk::End));
+}
+
 END_UNNAMED_NAMESPACE
@@ -6,8 +6,8 @@ BEGIN_MIDI_NAMESPACE
 // Declare references:
 // http://stackoverflow.com/questions/4891067/weird-undefined-symbols-of-static-constants-inside-a-struct-class
 
-template<unsigned Size>
-const unsigned Message<Size>::sSysExMaxSize;
+template<unsigned Size, bool Timestamps>
+const unsigned Message<Size, Timestamps>::sSysExMaxSize;
 
 END_MIDI_NAMESPACE
 
@@ -80,4 +80,46 @@ TEST(MidiMessage, getSysExSize)
     }
 }
 
+TEST(MidiMessage, shortMessage)
+{
+    typedef midi::Message<32> Message;
+    EXPECT_EQ(sizeof(midi::ShortMessage), size_t(4));
+
+    Message message = Message();
+    message.type    = midi::ControlChange;
+    message.channel = 16;
+    message.data1   = 12;
+    message.data2   = 34;
+    message.valid   = true;
+
+    const midi::ShortMessage compact = message.getShortMessage();
+    EXPECT_EQ(compact.status,       0xbf);
+    EXPECT_EQ(compact.data1,        12);
+    EXPECT_EQ(compact.data2,        34);
+    EXPECT_EQ(compact.isValid(),    true);
+    EXPECT_EQ(compact.getType(),    midi::ControlChange);
+    EXPECT_EQ(compact.getChannel(), 16);
+
+    Message restored = Message();
+    restored.setShortMessage(compact);
+    EXPECT_EQ(restored.type,        midi::ControlChange);
+    EXPECT_EQ(restored.channel,     16);
+    EXPECT_EQ(restored.data1,       12);
+    EXPECT_EQ(restored.data2,       34);
+    EXPECT_EQ(restored.valid,       true);
+
+    // System messages have no channel
+    message.type    = midi::SystemExclusive;
+    message.channel = 0;
+    setSysExSize(message, 300);
+    restored.setShortMessage(message.getShortMessage());
+    EXPECT_EQ(restored.type,        midi::SystemExclusive);
+    EXPECT_EQ(restored.channel,     0);
+    EXPECT_EQ(message.getShortMessage().getSysExSize(), unsigned(300));
+
+    restored.setShortMessage(Message().getShortMessage());
+    EXPECT_EQ(restored.type,        midi::InvalidType);
+    EXPECT_EQ(restored.valid,       false);
+}
+
 END_UNNAMED_NAMESPACE
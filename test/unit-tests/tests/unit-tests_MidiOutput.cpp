@@ -19,6 +19,17 @@ typedef midi::MidiInterface<SerialMock> MidiInterface;
 
 typedef std::vector<uint8_t> Buffer;
 
+struct BufferedSettings : public midi::DefaultSettings
+{
+    static const unsigned OutputBufferSize = 8;
+};
+
+struct NoteOffAsNoteOnSettings : public midi::DefaultSettings
+{
+    static const bool UseRunningStatus = true;
+    static const bool SendNoteOffAsNullVelocityNoteOn = true;
+};
+
 // --
 
 TEST(MidiOutput, sendInvalid)
@@ -115,6 +126,44 @@ TEST(MidiOutput, sendGenericBreakingRunningStatus)
     EXPECT_THAT(buffer, ElementsAreArray({0x9b, 47, 42, 0x8b, 47, 42}));
 }
 
+TEST(MidiOutput, sendNoteOffAsNullVelocityNoteOn)
+{
+    typedef midi::MidiInterface<SerialMock, NoteOffAsNoteOnSettings> RsMidiInterface;
+
+    SerialMock serial;
+    RsMidiInterface midi(serial);
+    Buffer buffer;
+    buffer.resize(21);
+
+    midi.begin();
+    midi.sendNoteOff(47, 64, 12);
+    midi.sendNoteOn(48, 42, 12);
+    midi.sendRealTime(midi::Clock);         // Does not break the run
+    midi.sendNoteOff(47, 0, 12);
+    midi.sendNoteOff(48, 42, 12);           // Release velocity is kept
+    midi.sendNoteOff(49, 64, 13);           // Other channel
+    midi.sendNoteOn(50, 42, 13);
+    midi.sendControlChange(1, 2, 13);
+    midi.sendControlChange(1, 3, 13);
+    EXPECT_EQ(serial.mTxBuffer.getLength(), 21);
+    serial.mTxBuffer.read(&buffer[0], 21);
+    EXPECT_THAT(buffer, ElementsAreArray({
+        0x9b, 47, 0,
+        48, 42,
+        0xf8,
+        47, 0,
+        0x8b, 48, 42,
+        0x9c, 49, 0,
+        50, 42,
+        0xbc, 1, 2,
+        1, 3
+    }));
+    EXPECT_EQ(midi.getRunningStatusSavings(), 4u);
+
+    midi.begin();
+    EXPECT_EQ(midi.getRunningStatusSavings(), 0u);
+}
+
 TEST(MidiOutput, sendGenericRealTimeShortcut)
 {
     SerialMock serial;
@@ -834,4 +883,112 @@ TEST(MidiOutput, runningStatusCancellation)
     }));
 }
 
+// -----------------------------------------------------------------------------
+
+TEST(MidiOutput, outputBuffer)
+{
+    typedef midi::MidiInterface<SerialMock, BufferedSettings> BufferedMidiInterface;
+
+    SerialMock serial;
+    BufferedMidiInterface midi(serial);
+    Buffer buffer;
+
+    midi.begin();
+    midi.sendNoteOn(12, 34, 1);
+    midi.sendRealTime(midi::Clock);
+    EXPECT_EQ(serial.mTxBuffer.getLength(), 0);
+    midi.flush();
+    EXPECT_EQ(serial.mWriteCalls, 1);
+    buffer.resize(4);
+    serial.mTxBuffer.read(&buffer[0], 4);
+    EXPECT_THAT(buffer, ElementsAreArray({ 0x90, 12, 34, 0xf8 }));
+
+    // Flushed when the next byte does not fit
+    midi.sendNoteOn(1, 2, 1);
+    midi.sendNoteOn(3, 4, 1);
+    midi.sendNoteOn(5, 6, 1);
+    EXPECT_EQ(serial.mWriteCalls, 2);
+    EXPECT_EQ(serial.mTxBuffer.getLength(), 8);
+    midi.flush();
+    midi.flush(); // Nothing left
+    EXPECT_EQ(serial.mWriteCalls, 3);
+    buffer.resize(9);
+    serial.mTxBuffer.read(&buffer[0], 9);
+    EXPECT_THAT(buffer, ElementsAreArray({ 0x90, 1, 2, 0x90, 3, 4, 0x90, 5, 6 }));
+
+    // Blocks larger than the buffer are written directly
+    static const byte sysex[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    midi.sendSysEx(sizeof(sysex), sysex);
+    midi.flush();
+    EXPECT_EQ(serial.mWriteCalls, 6);
+    buffer.resize(12);
+    serial.mTxBuffer.read(&buffer[0], 12);
+    EXPECT_THAT(buffer, ElementsAreArray({ 0xf0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 0xf7 }));
+}
+
+TEST(MidiOutput, outputBufferFlushesThru)
+{
+    typedef midi::MidiInterface<SerialMock, BufferedSettings> BufferedMidiInterface;
+
+    SerialMock serial;
+    BufferedMidiInterface midi(serial);
+    Buffer buffer;
+
+    midi.begin(MIDI_CHANNEL_OMNI);
+    static const byte rxData[] = { 0x9b, 12, 34, 56, 78 };
+    EXPECT_EQ(midi.read(rxData, sizeof(rxData)), 2u);
+    EXPECT_EQ(serial.mWriteCalls, 1);
+    buffer.resize(6);
+    serial.mTxBuffer.read(&buffer[0], 6);
+    EXPECT_THAT(buffer, ElementsAreArray({ 0x9b, 12, 34, 0x9b, 56, 78 }));
+
+    serial.mRxBuffer.write(rxData, 3);
+    EXPECT_EQ(midi.read(), false);
+    EXPECT_EQ(midi.read(), false);
+    EXPECT_EQ(midi.read(), true);
+    EXPECT_EQ(serial.mWriteCalls, 2);
+    EXPECT_EQ(serial.mTxBuffer.getLength(), 3);
+}
+
+TEST(MidiOutput, sendMessages)
+{
+    typedef midi::MidiInterface<SerialMock, BufferedSettings> BufferedMidiInterface;
+    typedef BufferedMidiInterface::MidiMessage Message;
+
+    SerialMock serial;
+    BufferedMidiInterface midi(serial);
+    Buffer buffer;
+
+    Message messages[5];
+    messages[0].type    = midi::NoteOn;
+    messages[0].channel = 3;
+    messages[0].data1   = 12;
+    messages[0].data2   = 34;
+    messages[1].type    = midi::Clock;
+    messages[2].type    = midi::SystemExclusive;
+    messages[2].data1   = 4;
+    messages[2].data2   = 0;
+    messages[2].sysexArray[0] = 0xf0;
+    messages[2].sysexArray[1] = 1;
+    messages[2].sysexArray[2] = 2;
+    messages[2].sysexArray[3] = 0xf7;
+    messages[3].type    = midi::SongPosition;
+    messages[3].data1   = 0x22;
+    messages[3].data2   = 0x11;
+    messages[4].type    = midi::ControlChange;
+    messages[4].channel = 3;
+    messages[4].data1   = 7;
+    messages[4].data2   = 100;
+
+    midi.begin();
+    midi.send(messages, 5);
+    EXPECT_EQ(serial.mWriteCalls, 2); // 8 bytes buffer
+    buffer.resize(14);
+    serial.mTxBuffer.read(&buffer[0], 14);
+    EXPECT_THAT(buffer, ElementsAreArray({
+        0x92, 12, 34, 0xf8, 0xf0, 1, 2, 0xf7,
+        0xf2, 0x22, 0x11, 0xb2, 7, 100
+    }));
+}
+
 END_UNNAMED_NAMESPACE
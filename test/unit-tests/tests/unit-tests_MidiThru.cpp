@@ -366,4 +366,188 @@ TEST(MidiThru, invalidMode)
     EXPECT_EQ(serial.mTxBuffer.getLength(), 0);
 }
 
+// -----------------------------------------------------------------------------
+
+template<unsigned Size>
+struct CutThroughSettings : VariableSysExSettings<Size>
+{
+    static const bool UseCutThroughThru = true;
+};
+
+Buffer readTx(SerialMock& inSerial)
+{
+    Buffer buffer(inSerial.mTxBuffer.getLength());
+    if (!buffer.empty())
+    {
+        inSerial.mTxBuffer.read(&buffer[0], int(buffer.size()));
+    }
+    return buffer;
+}
+
+TEST(MidiThru, cutThrough)
+{
+    typedef midi::MidiInterface<SerialMock, CutThroughSettings<8> > CutThroughMidiInterface;
+    SerialMock serial;
+    CutThroughMidiInterface midi(serial);
+    midi.begin(MIDI_CHANNEL_OMNI);
+
+    // Each byte is forwarded when it is parsed, Running Status is kept
+    static const byte rxData[] = { 0x9b, 12, 0xf8, 34, 56, 78 };
+    serial.mRxBuffer.write(rxData, sizeof(rxData));
+    EXPECT_EQ(midi.read(), false);
+    EXPECT_THAT(readTx(serial), ElementsAre(0x9b));
+    EXPECT_EQ(midi.read(), false);
+    EXPECT_THAT(readTx(serial), ElementsAre(12));
+    EXPECT_EQ(midi.read(), true);
+    EXPECT_THAT(readTx(serial), ElementsAre(0xf8));
+    EXPECT_EQ(midi.read(), true);
+    EXPECT_EQ(midi.read(), false);
+    EXPECT_EQ(midi.read(), true);
+    EXPECT_THAT(readTx(serial), ElementsAre(34, 56, 78));
+
+    // The status is sent again when another message was sent in between
+    static const byte rxRunning[] = { 1, 2 };
+    midi.sendControlChange(3, 4, 5);
+    EXPECT_EQ(midi.read(rxRunning, 2), unsigned(1));
+    EXPECT_THAT(readTx(serial), ElementsAre(0xb4, 3, 4, 0x9b, 1, 2));
+}
+
+TEST(MidiThru, cutThroughFilter)
+{
+    typedef midi::MidiInterface<SerialMock, CutThroughSettings<8> > CutThroughMidiInterface;
+    SerialMock serial;
+    CutThroughMidiInterface midi(serial);
+    midi.begin(12);
+
+    // Filtered out when the status byte arrives, Real Time is still sent.
+    // Messages on other channels are not counted by read.
+    static const byte rxData[] = { 0x9b, 12, 34, 0x9c, 56, 0xf8, 78, 90, 12, 0xf6 };
+    midi.setThruFilterMode(midi::Thru::SameChannel);
+    EXPECT_EQ(midi.read(rxData, sizeof(rxData)), unsigned(3));
+    EXPECT_THAT(readTx(serial), ElementsAre(0x9b, 12, 34, 0xf8, 0xf6));
+
+    midi.setThruFilterMode(midi::Thru::DifferentChannel);
+    EXPECT_EQ(midi.read(rxData, sizeof(rxData)), unsigned(3));
+    EXPECT_THAT(readTx(serial), ElementsAre(0x9c, 56, 0xf8, 78, 90, 12, 0xf6));
+
+    midi.turnThruOff();
+    EXPECT_EQ(midi.read(rxData, sizeof(rxData)), unsigned(3));
+    EXPECT_EQ(serial.mTxBuffer.getLength(), 0);
+}
+
+TEST(MidiThru, cutThroughSysEx)
+{
+    typedef midi::MidiInterface<SerialMock, CutThroughSettings<4> > CutThroughMidiInterface;
+    SerialMock serial;
+    CutThroughMidiInterface midi(serial);
+    midi.begin(MIDI_CHANNEL_OMNI);
+
+    static const byte rxData[] = { 0xf0, 1, 2, 0xf7 };
+    serial.mRxBuffer.write(rxData, sizeof(rxData));
+    EXPECT_EQ(midi.read(), false);
+    EXPECT_EQ(midi.read(), false);
+    EXPECT_THAT(readTx(serial), ElementsAre(0xf0, 1));
+    EXPECT_EQ(midi.read(), false);
+    EXPECT_EQ(midi.read(), true);
+    EXPECT_THAT(readTx(serial), ElementsAre(2, 0xf7));
+
+    // Too long for SysExMaxSize: the output gets a truncated message
+    static const byte rxLong[] = { 0xf0, 1, 2, 3, 4, 5, 0xf7, 0xc1, 6 };
+    EXPECT_EQ(midi.read(rxLong, sizeof(rxLong)), unsigned(1));
+    EXPECT_THAT(readTx(serial), ElementsAre(0xf0, 1, 2, 3, 0xf7, 0xc1, 6));
+}
+
+// -----------------------------------------------------------------------------
+
+class RecordingThruOutput : public midi::ThruOutput
+{
+public:
+    RecordingThruOutput(midi::Thru::Mode inFilterMode)
+        : midi::ThruOutput(inFilterMode)
+        , mWrites(0)
+    {
+    }
+
+    virtual void write(const byte* inData, unsigned inSize)
+    {
+        mBytes.insert(mBytes.end(), inData, inData + inSize);
+        mWrites++;
+    }
+
+public:
+    Buffer mBytes;
+    unsigned mWrites;
+};
+
+TEST(MidiThru, separateOutputs)
+{
+    SerialMock serial;
+    SerialMock serial2;
+    MidiInterface midi(serial);
+    midi::SerialThruOutput<SerialMock> output2(serial2);
+    RecordingThruOutput sameChannel(midi::Thru::SameChannel);
+    RecordingThruOutput differentChannel(midi::Thru::DifferentChannel);
+
+    midi.begin(12);
+    midi.turnThruOff();
+    midi.addThruOutput(output2);
+    midi.addThruOutput(sameChannel);
+    midi.addThruOutput(differentChannel);
+
+    static const byte rxData[] = { 0x9b, 12, 34, 0xf8, 56, 78, 0xcc, 42, 0xf0, 1, 2, 0xf7, 0xf1, 0x35 };
+    midi.read(rxData, sizeof(rxData));
+    EXPECT_EQ(serial.mTxBuffer.getLength(), 0);
+
+    // Full messages, without Running Status
+    EXPECT_THAT(readTx(serial2), ElementsAreArray({
+        0x9b, 12, 34, 0xf8, 0x9b, 56, 78, 0xcc, 42, 0xf0, 1, 2, 0xf7, 0xf1, 0x35
+    }));
+    EXPECT_THAT(sameChannel.mBytes, ElementsAreArray({
+        0x9b, 12, 34, 0xf8, 0x9b, 56, 78, 0xf0, 1, 2, 0xf7, 0xf1, 0x35
+    }));
+    EXPECT_THAT(differentChannel.mBytes, ElementsAreArray({
+        0xf8, 0xcc, 42, 0xf0, 1, 2, 0xf7, 0xf1, 0x35
+    }));
+
+    // One write per message
+    EXPECT_EQ(sameChannel.mWrites, unsigned(5));
+
+    // Detached outputs and Off filters receive nothing
+    midi.removeThruOutput(output2);
+    sameChannel.setFilterMode(midi::Thru::Off);
+    sameChannel.mBytes.clear();
+    differentChannel.mBytes.clear();
+    midi.read(rxData, 3);
+    EXPECT_EQ(serial2.mTxBuffer.getLength(), 0);
+    EXPECT_EQ(sameChannel.mBytes.size(), 0u);
+    EXPECT_EQ(differentChannel.mBytes.size(), 0u);
+
+    // The port keeps its own Thru
+    midi.turnThruOn(midi::Thru::Full);
+    midi.read(rxData, 8);
+    EXPECT_THAT(readTx(serial), ElementsAre(0x9b, 12, 34, 0xf8, 0x9b, 56, 78, 0xcc, 42));
+    EXPECT_THAT(differentChannel.mBytes, ElementsAre(0xf8, 0xcc, 42));
+}
+
+struct RealTimeFastPathSettings : midi::DefaultSettings
+{
+    static const bool UseRealTimeFastPath = true;
+};
+
+TEST(MidiThru, separateOutputsRealTimeFastPath)
+{
+    typedef midi::MidiInterface<SerialMock, RealTimeFastPathSettings> FastMidiInterface;
+    SerialMock serial;
+    FastMidiInterface midi(serial);
+    RecordingThruOutput output(midi::Thru::Full);
+
+    midi.begin(MIDI_CHANNEL_OMNI);
+    midi.turnThruOff();
+    midi.addThruOutput(output);
+
+    static const byte rxData[] = { 0x9b, 12, 0xf8, 34 };
+    midi.read(rxData, sizeof(rxData));
+    EXPECT_THAT(output.mBytes, ElementsAre(0xf8, 0x9b, 12, 34));
+}
+
 END_UNNAMED_NAMESPACE
@@ -0,0 +1,188 @@
+#include "unit-tests.h"
+#include <src/MIDI.h>
+#include <test/mocks/test-mocks_SerialMock.h>
+#include <algorithm>
+
+BEGIN_UNNAMED_NAMESPACE
+
+using namespace testing;
+USING_NAMESPACE_UNIT_TESTS
+typedef std::vector<byte> Buffer;
+
+// Checks the bounds documented on MidiInterface::read() against adversarial
+// input: stray data bytes, undefined and misplaced status bytes, Real Time
+// interleaving, SysEx overflows and unterminated SysEx.
+
+static const unsigned sSysExMaxSize = 16;
+static const unsigned sChunkSize    = 32;
+
+/*! SerialMock counting the calls made by the parser. */
+class CountingPort : public test_mocks::SerialMock<256>
+{
+public:
+    typedef test_mocks::SerialMock<256> SerialMock;
+
+    CountingPort()
+        : mAvailableCalls(0)
+        , mReadCalls(0)
+        , mWrittenBytes(0)
+    {
+    }
+
+    int available() const
+    {
+        mAvailableCalls++;
+        return SerialMock::available();
+    }
+
+    byte read()
+    {
+        mReadCalls++;
+        return SerialMock::read();
+    }
+
+    void write(byte inData)
+    {
+        mWrittenBytes++;
+        SerialMock::write(inData);
+    }
+
+    void resetCounters()
+    {
+        mAvailableCalls = 0;
+        mReadCalls      = 0;
+        mWrittenBytes   = 0;
+    }
+
+public:
+    mutable int mAvailableCalls;
+    int mReadCalls;
+    int mWrittenBytes;
+};
+
+template<bool OneByteParsing, unsigned QueueSize, bool CutThrough>
+struct BoundsSettings : midi::DefaultSettings
+{
+    static const bool Use1ByteParsing = OneByteParsing;
+    static const unsigned MessageQueueSize = QueueSize;
+    static const bool UseCutThroughThru = CutThrough;
+    static const unsigned SysExMaxSize = sSysExMaxSize;
+};
+
+unsigned handledMessages = 0;
+
+void handleMessage(const midi::Message<sSysExMaxSize>&)
+{
+    handledMessages++;
+}
+
+Buffer makeAdversarialStream(unsigned inSize)
+{
+    static const byte statuses[] = {
+        0x90, 0x8f, 0xb3, 0xc0, 0xd5, 0xe0,     // Channel messages
+        0xf0, 0xf1, 0xf2, 0xf3, 0xf6, 0xf7,     // System Common, EOX
+        0xf4, 0xf5, 0xf9, 0xfd,                 // Undefined
+        0xf8, 0xfa, 0xfe, 0xff,                 // Real Time
+    };
+    Buffer stream;
+    unsigned state = 0x4d494449;
+    while (stream.size() < inSize)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        if (state & 1)
+        {
+            stream.push_back(byte((state >> 8) & 0x7f));
+            continue;
+        }
+        const byte status = statuses[(state >> 8) % sizeof(statuses)];
+        stream.push_back(status);
+        if (status == 0xf0)
+        {
+            // Up to twice SysExMaxSize, overflowing half of the time.
+            for (unsigned i = (state >> 16) % (2 * sSysExMaxSize); i > 0; --i)
+            {
+                stream.push_back(byte(i & 0x7f));
+            }
+        }
+    }
+    return stream;
+}
+
+template<class Settings>
+void checkBounds()
+{
+    const Buffer stream = makeAdversarialStream(20000);
+    CountingPort port;
+    midi::MidiInterface<CountingPort, Settings> midi(port);
+    midi.begin(MIDI_CHANNEL_OMNI);
+    midi.setHandleMessage(handleMessage);
+
+    const bool readsOneByte = Settings::Use1ByteParsing && Settings::MessageQueueSize == 0;
+    unsigned calls = 0;
+    unsigned messages = 0;
+    handledMessages = 0;
+
+    for (unsigned offset = 0; offset < stream.size(); offset += sChunkSize)
+    {
+        const unsigned size = std::min(sChunkSize, unsigned(stream.size()) - offset);
+        port.mRxBuffer.write(&stream[offset], int(size));
+
+        while (port.mRxBuffer.getLength() > 0)
+        {
+            const int available = port.mRxBuffer.getLength();
+            port.resetCounters();
+            const unsigned handledBefore = handledMessages;
+
+            midi.read();
+            calls++;
+
+            ASSERT_EQ(port.mAvailableCalls, 1);
+            if (Settings::MessageQueueSize == 0)
+            {
+                // Otherwise nothing is read while the queue is full.
+                ASSERT_GE(port.mReadCalls, 1);
+            }
+            ASSERT_LE(port.mReadCalls, readsOneByte ? 1 : available);
+            ASSERT_LE(handledMessages - handledBefore, 1u);
+            if (Settings::UseCutThroughThru)
+            {
+                ASSERT_LE(port.mWrittenBytes, 2 * port.mReadCalls);
+            }
+            else
+            {
+                ASSERT_LE(port.mWrittenBytes, int(sSysExMaxSize));
+            }
+            messages += handledMessages - handledBefore;
+        }
+    }
+
+    // The stream is adversarial, not garbage: messages do get through.
+    EXPECT_GT(messages, 1000u);
+    EXPECT_GE(calls, readsOneByte ? unsigned(stream.size()) : messages);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST(ParserBounds, oneByteParsing)
+{
+    checkBounds<BoundsSettings<true, 0, false> >();
+}
+
+TEST(ParserBounds, multiByteParsing)
+{
+    checkBounds<BoundsSettings<false, 0, false> >();
+}
+
+TEST(ParserBounds, messageQueue)
+{
+    checkBounds<BoundsSettings<true, 8, false> >();
+}
+
+TEST(ParserBounds, cutThroughThru)
+{
+    checkBounds<BoundsSettings<false, 0, true> >();
+}
+
+END_UNNAMED_NAMESPACE
@@ -0,0 +1,171 @@
+#include "unit-tests.h"
+#include <src/midi_RingBuffer.h>
+#include <thread>
+
+BEGIN_MIDI_NAMESPACE
+
+END_MIDI_NAMESPACE
+
+// -----------------------------------------------------------------------------
+
+BEGIN_UNNAMED_NAMESPACE
+
+using namespace testing;
+using midi::RingBuffer;
+
+TEST(MidiRingBuffer, initialState)
+{
+    typedef RingBuffer<byte, 32> Buffer;
+    Buffer buffer;
+    EXPECT_EQ(buffer.getLength(), 0);
+    EXPECT_EQ(buffer.isEmpty(),   true);
+    EXPECT_EQ(buffer.isFull(),    false);
+}
+
+TEST(MidiRingBuffer, overflow)
+{
+    typedef RingBuffer<byte, 8> Buffer;
+    Buffer buffer;
+    const byte data[] = "Hello, World!";
+
+    EXPECT_EQ(buffer.write(data, 13), 8);
+    EXPECT_EQ(buffer.getLength(), 8);
+    EXPECT_EQ(buffer.isFull(),    true);
+    EXPECT_EQ(buffer.write('!'),  false);
+
+    byte output[8] = { 0 };
+    EXPECT_EQ(buffer.read(output, 3), 3);
+    EXPECT_EQ(buffer.write(data + 8, 5), 3);
+
+    const byte expected[8] = {
+        'l', 'o', ',', ' ', 'W', 'o', 'r', 'l',
+    };
+    EXPECT_EQ(buffer.read(output, 16), 8);
+    EXPECT_THAT(output, ContainerEq(expected));
+    EXPECT_EQ(buffer.isEmpty(),   true);
+}
+
+TEST(MidiRingBuffer, indexWrapping)
+{
+    // Byte indices for small buffers, unsigned ones above 128 elements
+    typedef RingBuffer<unsigned, 128> SmallBuffer;
+    typedef RingBuffer<unsigned, 256> LargeBuffer;
+    SmallBuffer small;
+    LargeBuffer large;
+
+    for (unsigned i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(small.write(i), true);
+        EXPECT_EQ(large.write(i), true);
+        EXPECT_EQ(small.getLength(), 1);
+        EXPECT_EQ(large.getLength(), 1);
+        EXPECT_EQ(small.read(), i);
+        EXPECT_EQ(large.read(), i);
+    }
+
+    large.write(42);
+    large.clear();
+    EXPECT_EQ(large.isEmpty(), true);
+}
+
+TEST(MidiRingBuffer, blockCopyWrapping)
+{
+    typedef RingBuffer<byte, 8> Buffer;
+    Buffer buffer;
+    const byte data[] = "0123456789";
+    byte output[8] = { 0 };
+
+    buffer.write(data, 6);
+    EXPECT_EQ(buffer.read(output, 4), 4);
+    EXPECT_EQ(buffer.peek(),      '4');
+    EXPECT_EQ(buffer.write(data, 6), 6); // Wraps
+    EXPECT_EQ(buffer.getLength(), 8);
+    EXPECT_EQ(buffer.peek(),      '4');
+
+    const byte expected[8] = { '4', '5', '0', '1', '2', '3', '4', '5' };
+    EXPECT_EQ(buffer.read(output, 8), 8);
+    EXPECT_THAT(output, ContainerEq(expected));
+    EXPECT_EQ(buffer.peek(),      0);
+    EXPECT_EQ(buffer.read(),      0);
+    EXPECT_EQ(buffer.getLength(), 0);
+}
+
+TEST(MidiRingBuffer, spans)
+{
+    typedef RingBuffer<byte, 8> Buffer;
+    Buffer buffer;
+    int size = 0;
+
+    byte* writeSpan = buffer.getWriteSpan(size);
+    EXPECT_EQ(size, 8);
+    memcpy(writeSpan, "abcdef", 6);
+    buffer.commitWrite(6);
+
+    const byte* readSpan = buffer.getReadSpan(size);
+    EXPECT_EQ(size, 6);
+    EXPECT_EQ(readSpan[0], 'a');
+    buffer.commitRead(5);
+
+    // Free space is split in two at the end of the storage
+    writeSpan = buffer.getWriteSpan(size);
+    EXPECT_EQ(size, 2);
+    memcpy(writeSpan, "gh", 2);
+    buffer.commitWrite(2);
+    writeSpan = buffer.getWriteSpan(size);
+    EXPECT_EQ(size, 5);
+    writeSpan[0] = 'i';
+    buffer.commitWrite(1);
+
+    readSpan = buffer.getReadSpan(size);
+    EXPECT_EQ(size, 3);
+    EXPECT_EQ(readSpan[0], 'f');
+    buffer.commitRead(3);
+    readSpan = buffer.getReadSpan(size);
+    EXPECT_EQ(size, 1);
+    EXPECT_EQ(readSpan[0], 'i');
+    buffer.commitRead(1);
+    EXPECT_EQ(buffer.isEmpty(), true);
+}
+
+TEST(MidiRingBuffer, concurrentProducerConsumer)
+{
+    typedef RingBuffer<unsigned, 16> Buffer;
+    static const unsigned count = 200000;
+    Buffer buffer;
+
+    std::thread producer([&buffer]()
+    {
+        for (unsigned i = 0; i < count; )
+        {
+            if (buffer.write(i))
+            {
+                ++i;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    unsigned expected = 0;
+    unsigned errors = 0;
+    while (expected < count)
+    {
+        if (!buffer.isEmpty())
+        {
+            errors += buffer.read() != expected;
+            ++expected;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    EXPECT_EQ(errors, unsigned(0));
+    EXPECT_EQ(buffer.isEmpty(), true);
+}
+
+END_UNNAMED_NAMESPACE
@@ -0,0 +1,278 @@
+#include "unit-tests.h"
+#include <src/MIDI.h>
+#include <src/midi_Router.h>
+#include <test/mocks/test-mocks_SerialMock.h>
+
+BEGIN_UNNAMED_NAMESPACE
+
+using namespace testing;
+USING_NAMESPACE_UNIT_TESTS
+typedef test_mocks::SerialMock<64> SerialMock;
+typedef std::vector<byte> Buffer;
+
+struct RouterSettings : midi::DefaultSettings
+{
+    static const bool UseRealTimeFastPath = true;
+    static const unsigned MessageQueueSize = 8;
+    static const unsigned SysExMaxSize = 16;
+};
+
+struct ChunkSettings : RouterSettings
+{
+    static const unsigned SysExMaxSize = 4;
+};
+
+struct UnqueuedChunkSettings : ChunkSettings
+{
+    static const unsigned MessageQueueSize = 0;
+};
+
+typedef midi::MidiInterface<SerialMock, RouterSettings> MidiInterface;
+typedef midi::MidiInterface<SerialMock, ChunkSettings> ChunkMidiInterface;
+typedef midi::MidiInterface<SerialMock, UnqueuedChunkSettings> UnqueuedChunkMidiInterface;
+
+class RecordingOutput : public midi::ThruOutput
+{
+public:
+    virtual void write(const byte* inData, unsigned inSize)
+    {
+        mBytes.insert(mBytes.end(), inData, inData + inSize);
+    }
+
+public:
+    Buffer mBytes;
+};
+
+void receive(SerialMock& inSerial, const byte* inData, unsigned inSize)
+{
+    inSerial.mRxBuffer.write(inData, int(inSize));
+}
+
+void ignoreChunk(byte*, unsigned, byte)
+{
+}
+
+// -----------------------------------------------------------------------------
+
+TEST(Router, limits)
+{
+    SerialMock serial;
+    MidiInterface midi(serial);
+    RecordingOutput output;
+    midi::Router<MidiInterface, 1, 1> router;
+
+    midi.begin();
+    EXPECT_EQ(router.addInput(midi), true);
+    EXPECT_EQ(router.addInput(midi), false);
+    EXPECT_EQ(router.addOutput(output), true);
+    EXPECT_EQ(router.addOutput(output), false);
+    EXPECT_EQ(router.getInputCount(), 1u);
+    EXPECT_EQ(router.getOutputCount(), 1u);
+    EXPECT_EQ(midi.getThruState(), false);
+}
+
+TEST(Router, routingMatrix)
+{
+    SerialMock serialA;
+    SerialMock serialB;
+    MidiInterface midiA(serialA);
+    MidiInterface midiB(serialB);
+    RecordingOutput output0;
+    RecordingOutput output1;
+    midi::Router<MidiInterface, 2, 2> router;
+
+    midiA.begin();
+    midiB.begin();
+    router.addInput(midiA);
+    router.addInput(midiB);
+    router.addOutput(output0);
+    router.addOutput(output1);
+    router.setRoute(0, 0);
+    router.setRoute(0, 1, 0x0001, midi::Route::NoteOns | midi::Route::NoteOffs);
+    router.setRoute(1, 1, midi::Route::AllChannels, midi::Route::SystemCommons);
+
+    // Running Status is expanded, messages are sent whole
+    static const byte rxA[] = { 0x90, 12, 34, 56, 78, 0x91, 1, 2, 0xb0, 7, 100, 0xf3, 4 };
+    static const byte rxB[] = { 0x92, 3, 4, 0xf2, 1, 2 };
+    receive(serialA, rxA, sizeof(rxA));
+    receive(serialB, rxB, sizeof(rxB));
+
+    unsigned count = 0;
+    for (int i = 0; i < 8; ++i)
+    {
+        count += router.update();
+    }
+    EXPECT_EQ(count, 7u);
+    EXPECT_THAT(output0.mBytes, ElementsAreArray({
+        0x90, 12, 34, 0x90, 56, 78, 0x91, 1, 2, 0xb0, 7, 100, 0xf3, 4
+    }));
+    EXPECT_THAT(output1.mBytes, ElementsAreArray({
+        0x90, 12, 34, 0xf2, 1, 2, 0x90, 56, 78
+    }));
+
+    router.clearRoute(0, 0);
+    static const byte rxA2[] = { 0x80, 1, 2 };
+    receive(serialA, rxA2, sizeof(rxA2));
+    EXPECT_EQ(router.update(), 1u);
+    EXPECT_EQ(output0.mBytes.size(), 14u);
+    EXPECT_THAT(output1.mBytes, ElementsAreArray({
+        0x90, 12, 34, 0xf2, 1, 2, 0x90, 56, 78, 0x80, 1, 2
+    }));
+}
+
+TEST(Router, fairScheduling)
+{
+    SerialMock serialA;
+    SerialMock serialB;
+    MidiInterface midiA(serialA);
+    MidiInterface midiB(serialB);
+    RecordingOutput output;
+    midi::Router<MidiInterface, 2, 1> router;
+
+    midiA.begin();
+    midiB.begin();
+    router.addInput(midiA);
+    router.addInput(midiB);
+    router.addOutput(output);
+    router.setRoute(0, 0);
+    router.setRoute(1, 0);
+
+    // A busy input does not hold the other one back
+    static const byte rxA[] = { 0xc0, 1, 0xc0, 2, 0xc0, 3, 0xc0, 4 };
+    static const byte rxB[] = { 0xc1, 5 };
+    receive(serialA, rxA, sizeof(rxA));
+    receive(serialB, rxB, sizeof(rxB));
+
+    EXPECT_EQ(router.update(), 2u);
+    EXPECT_EQ(router.update(), 1u);
+    EXPECT_EQ(router.update(), 1u);
+    EXPECT_EQ(router.update(), 1u);
+    EXPECT_EQ(router.update(), 0u);
+    EXPECT_THAT(output.mBytes, ElementsAreArray({
+        0xc0, 1, 0xc1, 5, 0xc0, 2, 0xc0, 3, 0xc0, 4
+    }));
+
+    // The first input served alternates
+    output.mBytes.clear();
+    static const byte rxA2[] = { 0xc0, 6 };
+    static const byte rxB2[] = { 0xc1, 7 };
+    receive(serialA, rxA2, sizeof(rxA2));
+    receive(serialB, rxB2, sizeof(rxB2));
+    EXPECT_EQ(router.update(), 2u);
+    EXPECT_THAT(output.mBytes, ElementsAreArray({ 0xc1, 7, 0xc0, 6 }));
+}
+
+TEST(Router, sysExIsAtomic)
+{
+    SerialMock serialA;
+    SerialMock serialB;
+    ChunkMidiInterface midiA(serialA);
+    ChunkMidiInterface midiB(serialB);
+    RecordingOutput output;
+    RecordingOutput otherOutput;
+    midi::Router<ChunkMidiInterface, 2, 2> router;
+
+    midiA.begin();
+    midiB.begin();
+    midiA.setHandleSystemExclusiveChunk(ignoreChunk);
+    router.addInput(midiA);
+    router.addInput(midiB);
+    router.addOutput(output);
+    router.addOutput(otherOutput);
+    router.setRoute(0, 0);
+    router.setRoute(1, 0);
+    router.setRoute(1, 1);
+
+    // Received in chunks of 4 bytes
+    static const byte rxA[] = { 0xf0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 0xf7 };
+    receive(serialA, rxA, sizeof(rxA));
+    EXPECT_EQ(router.update(), 1u);
+    EXPECT_THAT(output.mBytes, ElementsAreArray({ 0xf0, 1, 2, 3 }));
+
+    // Meanwhile, the other input only sends Real Time messages
+    static const byte rxB[] = { 0x90, 1, 2, 0xf8 };
+    receive(serialB, rxB, sizeof(rxB));
+    EXPECT_EQ(router.update(), 1u);
+    EXPECT_THAT(output.mBytes, ElementsAreArray({ 0xf0, 1, 2, 3, 0xf8, 4, 5, 6, 7 }));
+    EXPECT_THAT(otherOutput.mBytes, ElementsAreArray({ 0xf8 }));
+
+    // Released after the last chunk
+    EXPECT_EQ(router.update(), 2u);
+    EXPECT_THAT(output.mBytes, ElementsAreArray({ 0xf0, 1, 2, 3, 0xf8, 4, 5, 6, 7, 8, 9, 0xf7, 0x90, 1, 2 }));
+    EXPECT_THAT(otherOutput.mBytes, ElementsAreArray({ 0xf8, 0x90, 1, 2 }));
+}
+
+TEST(Router, sysExIsAtomicWithoutQueue)
+{
+    SerialMock serialA;
+    SerialMock serialB;
+    UnqueuedChunkMidiInterface midiA(serialA);
+    UnqueuedChunkMidiInterface midiB(serialB);
+    RecordingOutput output;
+    midi::Router<UnqueuedChunkMidiInterface, 2, 1> router;
+
+    midiA.begin();
+    midiB.begin();
+    midiA.setHandleSystemExclusiveChunk(ignoreChunk);
+    router.addInput(midiA);
+    router.addInput(midiB);
+    router.addOutput(output);
+    router.setRoute(0, 0);
+    router.setRoute(1, 0);
+
+    static const byte rxA[] = { 0xf0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 0xf7 };
+    receive(serialA, rxA, sizeof(rxA));
+    EXPECT_EQ(router.update(), 1u);
+    EXPECT_THAT(output.mBytes, ElementsAreArray({ 0xf0, 1, 2, 3 }));
+
+    // Real Time messages are parsed while the input is held
+    static const byte clocks[] = { 0xf8, 0xf8 };
+    receive(serialB, clocks, sizeof(clocks));
+    EXPECT_EQ(router.update(), 1u);
+    EXPECT_EQ(serialB.mRxBuffer.getLength(), 0);
+    EXPECT_THAT(output.mBytes, ElementsAreArray({ 0xf0, 1, 2, 3, 0xf8, 0xf8, 4, 5, 6, 7 }));
+
+    // up to a message, that waits in the input
+    static const byte rxB[] = { 0xf8, 0x90, 1, 2, 0xf8 };
+    receive(serialB, rxB, sizeof(rxB));
+    EXPECT_EQ(router.update(), 1u);
+    EXPECT_EQ(serialB.mRxBuffer.getLength(), 1);
+    EXPECT_THAT(output.mBytes, ElementsAreArray({ 0xf0, 1, 2, 3, 0xf8, 0xf8, 4, 5, 6, 7,
+                                                  8, 9, 10, 11, 0xf8 }));
+
+    // Released after the last chunk
+    EXPECT_EQ(router.update(), 1u);
+    EXPECT_THAT(output.mBytes, ElementsAreArray({ 0xf0, 1, 2, 3, 0xf8, 0xf8, 4, 5, 6, 7,
+                                                  8, 9, 10, 11, 0xf8, 0xf7 }));
+    EXPECT_EQ(router.update(), 1u);
+    EXPECT_EQ(router.update(), 0u);
+    EXPECT_THAT(output.mBytes, ElementsAreArray({ 0xf0, 1, 2, 3, 0xf8, 0xf8, 4, 5, 6, 7,
+                                                  8, 9, 10, 11, 0xf8, 0xf7, 0x90, 1, 2, 0xf8 }));
+}
+
+TEST(Router, realTimeRoutes)
+{
+    SerialMock serialA;
+    MidiInterface midiA(serialA);
+    RecordingOutput clocks;
+    RecordingOutput notes;
+    midi::Router<MidiInterface, 1, 2> router;
+
+    midiA.begin();
+    router.addInput(midiA);
+    router.addOutput(clocks);
+    router.addOutput(notes);
+    router.setRoute(0, 0, midi::Route::NoChannel, midi::Route::RealTimes);
+    router.setRoute(0, 1, midi::Route::AllChannels, midi::Route::ChannelMessages);
+
+    // Real Time messages go ahead of the queue
+    static const byte rxA[] = { 0x90, 1, 2, 0x90, 3, 0xf8, 4, 0xfa };
+    receive(serialA, rxA, sizeof(rxA));
+    EXPECT_EQ(router.update(), 1u);
+    EXPECT_THAT(clocks.mBytes, ElementsAreArray({ 0xf8, 0xfa }));
+    EXPECT_THAT(notes.mBytes, ElementsAreArray({ 0x90, 1, 2 }));
+    EXPECT_EQ(router.update(), 1u);
+    EXPECT_THAT(notes.mBytes, ElementsAreArray({ 0x90, 1, 2, 0x90, 3, 4 }));
+}
+
+END_UNNAMED_NAMESPACE
@@ -0,0 +1,170 @@
+#include "unit-tests.h"
+#include <src/MIDI.h>
+#include <src/midi_Scheduler.h>
+#include <test/mocks/test-mocks_SerialMock.h>
+
+BEGIN_UNNAMED_NAMESPACE
+
+using namespace testing;
+USING_NAMESPACE_UNIT_TESTS
+typedef test_mocks::SerialMock<64> SerialMock;
+typedef std::vector<byte> Buffer;
+
+unsigned long sNow = 0;
+
+struct FakePlatform
+{
+    static unsigned long now()
+    {
+        return sNow;
+    }
+};
+
+struct BufferedSettings : midi::DefaultSettings
+{
+    static const unsigned OutputBufferSize = 16;
+};
+
+typedef midi::MidiInterface<SerialMock, midi::DefaultSettings, FakePlatform> MidiInterface;
+typedef midi::MidiInterface<SerialMock, BufferedSettings, FakePlatform> BufferedMidiInterface;
+
+Buffer readTx(SerialMock& inSerial)
+{
+    Buffer buffer(inSerial.mTxBuffer.getLength());
+    if (!buffer.empty())
+    {
+        inSerial.mTxBuffer.read(&buffer[0], int(buffer.size()));
+    }
+    return buffer;
+}
+
+// -----------------------------------------------------------------------------
+
+TEST(TimedQueue, orderedByTimeThenInsertion)
+{
+    midi::TimedQueue<8> queue;
+    midi::ShortMessage message = { 0, 0, 0, 0 };
+    static const unsigned long times[] = { 50, 10, 30, 10, 70, 30, 20 };
+
+    for (unsigned i = 0; i < 7; ++i)
+    {
+        message.data1 = byte(i);
+        EXPECT_EQ(queue.push(times[i], message), true);
+    }
+    EXPECT_EQ(queue.getLength(), 7u);
+
+    std::vector<unsigned> order;
+    while (!queue.isEmpty())
+    {
+        order.push_back(queue.getTop().data1);
+        queue.pop();
+    }
+    EXPECT_THAT(order, ElementsAreArray({ 1, 3, 6, 2, 5, 0, 4 }));
+}
+
+TEST(TimedQueue, full)
+{
+    midi::TimedQueue<2> queue;
+    midi::ShortMessage message = { 0, 0, 0, 0 };
+
+    EXPECT_EQ(queue.push(1, message), true);
+    EXPECT_EQ(queue.push(2, message), true);
+    EXPECT_EQ(queue.isFull(), true);
+    EXPECT_EQ(queue.push(0, message), false);
+    queue.clear();
+    EXPECT_EQ(queue.isEmpty(), true);
+}
+
+TEST(TimedQueue, clockWrapsAround)
+{
+    midi::TimedQueue<4> queue;
+    midi::ShortMessage message = { 0, 0, 0, 0 };
+
+    message.data1 = 1;
+    queue.push(5, message);                 // After the wrap
+    message.data1 = 2;
+    queue.push((unsigned long)-10, message);
+    EXPECT_EQ(queue.getTop().data1, 2);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST(Scheduler, sendsWhenDue)
+{
+    SerialMock serial;
+    MidiInterface midi(serial);
+    midi::Scheduler<MidiInterface, 8> scheduler(midi);
+
+    midi.begin();
+    sNow = 1000;
+    EXPECT_EQ(scheduler.schedule(1500, midi::NoteOff, 60, 0, 1), true);
+    EXPECT_EQ(scheduler.schedule(1000, midi::NoteOn, 60, 100, 1), true);
+    EXPECT_EQ(scheduler.schedule(1200, midi::ControlChange, 7, 90, 2), true);
+    EXPECT_EQ(scheduler.getLength(), 3u);
+
+    unsigned long next = 0;
+    EXPECT_EQ(scheduler.getNextTime(next), true);
+    EXPECT_EQ(next, 1000ul);
+
+    EXPECT_EQ(scheduler.service(), 1u);
+    EXPECT_THAT(readTx(serial), ElementsAreArray({ 0x90, 60, 100 }));
+
+    sNow = 1199;
+    EXPECT_EQ(scheduler.service(), 0u);
+    EXPECT_EQ(serial.mTxBuffer.getLength(), 0);
+
+    sNow = 2000;
+    EXPECT_EQ(scheduler.service(), 2u);
+    EXPECT_THAT(readTx(serial), ElementsAreArray({ 0xb1, 7, 90, 0x80, 60, 0 }));
+    EXPECT_EQ(scheduler.getNextTime(next), false);
+}
+
+TEST(Scheduler, realTimeFirst)
+{
+    SerialMock serial;
+    BufferedMidiInterface midi(serial);
+    midi::Scheduler<BufferedMidiInterface, 8, 2> scheduler(midi);
+
+    midi.begin();
+    scheduler.schedule(100, midi::NoteOn, 60, 100, 1);
+    scheduler.schedule(100, midi::NoteOn, 64, 100, 1);
+    EXPECT_EQ(scheduler.scheduleRealTime(110, midi::Clock), true);
+    EXPECT_EQ(scheduler.schedule(105, midi::Start, 0, 0, 0), true);
+    EXPECT_EQ(scheduler.scheduleRealTime(120, midi::Clock), false); // Lane full
+    EXPECT_EQ(scheduler.scheduleRealTime(120, midi::NoteOn), false);
+
+    unsigned long next = 0;
+    EXPECT_EQ(scheduler.getNextTime(next), true);
+    EXPECT_EQ(next, 100ul);
+
+    // All sent with a single write
+    EXPECT_EQ(scheduler.service(200), 4u);
+    EXPECT_EQ(serial.mWriteCalls, 1);
+    EXPECT_THAT(readTx(serial), ElementsAreArray({ 0xfa, 0xf8, 0x90, 60, 100, 0x90, 64, 100 }));
+}
+
+TEST(Scheduler, systemMessages)
+{
+    SerialMock serial;
+    MidiInterface midi(serial);
+    midi::Scheduler<MidiInterface, 8> scheduler(midi);
+
+    midi.begin();
+    EXPECT_EQ(scheduler.schedule(1, midi::SongPosition, 0x22, 0x11, 0), true);
+    EXPECT_EQ(scheduler.schedule(2, midi::SongSelect, 3, 0, 0), true);
+    EXPECT_EQ(scheduler.schedule(3, midi::TimeCodeQuarterFrame, 0x35, 0, 0), true);
+    EXPECT_EQ(scheduler.schedule(4, midi::TuneRequest, 0, 0, 0), true);
+    EXPECT_EQ(scheduler.schedule(5, midi::SystemExclusive, 0, 0, 0), false);
+    EXPECT_EQ(scheduler.schedule(5, midi::InvalidType, 0, 0, 0), false);
+    EXPECT_EQ(scheduler.schedule(5, midi::NoteOn, 1, 2, MIDI_CHANNEL_OMNI), false);
+    EXPECT_EQ(scheduler.schedule(5, midi::NoteOn, 1, 2, MIDI_CHANNEL_OFF), false);
+
+    EXPECT_EQ(scheduler.service(10), 4u);
+    EXPECT_THAT(readTx(serial), ElementsAreArray({ 0xf2, 0x22, 0x11, 0xf3, 3, 0xf1, 0x35, 0xf6 }));
+
+    scheduler.schedule(20, midi::NoteOn, 1, 2, 3);
+    scheduler.clear();
+    EXPECT_EQ(scheduler.getLength(), 0u);
+}
+
+END_UNNAMED_NAMESPACE
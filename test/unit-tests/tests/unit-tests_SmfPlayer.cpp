@@ -0,0 +1,281 @@
+#include "unit-tests.h"
+#include <src/MIDI.h>
+#include <src/midi_SmfPlayer.h>
+#include <test/mocks/test-mocks_SerialMock.h>
+#include <stdio.h>
+#include <unistd.h>
+
+BEGIN_UNNAMED_NAMESPACE
+
+using namespace testing;
+USING_NAMESPACE_UNIT_TESTS
+typedef test_mocks::SerialMock<256> SerialMock;
+typedef std::vector<byte> Buffer;
+
+struct FakePlatform
+{
+    static unsigned long now()
+    {
+        return 0;
+    }
+};
+
+typedef midi::MidiInterface<SerialMock, midi::DefaultSettings, FakePlatform> MidiInterface;
+typedef midi::SmfPlayer<MidiInterface, midi::SmfMemorySource> SmfPlayer;
+
+Buffer readTx(SerialMock& inSerial)
+{
+    Buffer buffer(inSerial.mTxBuffer.getLength());
+    if (!buffer.empty())
+    {
+        inSerial.mTxBuffer.read(&buffer[0], int(buffer.size()));
+    }
+    return buffer;
+}
+
+void appendBigEndian(Buffer& ioFile, unsigned long inValue, unsigned inSize)
+{
+    for (unsigned i = inSize; i > 0; --i)
+    {
+        ioFile.push_back(byte(inValue >> (8 * (i - 1))));
+    }
+}
+
+Buffer makeHeader(unsigned inFormat, unsigned inTracks, unsigned inDivision)
+{
+    static const byte magic[4] = { 'M', 'T', 'h', 'd' };
+    Buffer file(magic, magic + 4);
+    appendBigEndian(file, 6, 4);
+    appendBigEndian(file, inFormat, 2);
+    appendBigEndian(file, inTracks, 2);
+    appendBigEndian(file, inDivision, 2);
+    return file;
+}
+
+void appendChunk(Buffer& ioFile, const char* inType, const byte* inData, unsigned inSize)
+{
+    ioFile.insert(ioFile.end(), inType, inType + 4);
+    appendBigEndian(ioFile, inSize, 4);
+    ioFile.insert(ioFile.end(), inData, inData + inSize);
+}
+
+// -----------------------------------------------------------------------------
+
+TEST(SmfPlayer, formatZeroRunningStatus)
+{
+    static const byte track[] = {
+        0x00, 0x90, 60, 100,            // NoteOn
+        0x00, 64, 100,                  // NoteOn, Running Status
+        0x83, 0x60, 0x80, 60, 64,       // NoteOff after 480 ticks
+        0x00, 0xc1, 5,                  // ProgramChange
+        0x00, 0xff, 0x2f, 0x00,         // End of track
+    };
+    Buffer file = makeHeader(0, 1, 480);
+    appendChunk(file, "MTrk", track, sizeof(track));
+
+    SerialMock serial;
+    MidiInterface midi(serial);
+    midi.begin(MIDI_CHANNEL_OMNI);
+    midi::SmfMemorySource source(&file[0], file.size());
+    SmfPlayer player(midi);
+
+    EXPECT_EQ(player.open(source), true);
+    EXPECT_EQ(player.getFormat(), 0u);
+    EXPECT_EQ(player.getTrackCount(), 1u);
+    EXPECT_EQ(player.isPlaying(), false);
+    EXPECT_EQ(player.service(1000), 0u);
+
+    player.start(1000);
+    unsigned long next = 0;
+    EXPECT_EQ(player.getNextTime(next), true);
+    EXPECT_EQ(next, 1000ul);
+    EXPECT_EQ(player.service(1000), 2u);
+
+    static const byte noteOns[6] = { 0x90, 60, 100, 0x90, 64, 100 };
+    EXPECT_THAT(readTx(serial), ElementsAreArray(noteOns));
+
+    // A quarter note at 120 BPM.
+    EXPECT_EQ(player.getNextTime(next), true);
+    EXPECT_EQ(next, 501000ul);
+    EXPECT_EQ(player.service(500999), 0u);
+    EXPECT_EQ(player.service(501000), 2u);
+    static const byte noteOff[5] = { 0x80, 60, 64, 0xc1, 5 };
+    EXPECT_THAT(readTx(serial), ElementsAreArray(noteOff));
+    EXPECT_EQ(player.isPlaying(), false);
+    EXPECT_EQ(player.getNextTime(next), false);
+}
+
+TEST(SmfPlayer, formatOneTempoMap)
+{
+    static const byte tempoTrack[] = {
+        0x00, 0xff, 0x03, 0x04, 'S', 'o', 'n', 'g',     // Track name, skipped
+        0x83, 0x60, 0xff, 0x51, 0x03, 0x03, 0xd0, 0x90, // 250000 us per quarter at 480
+        0x00, 0xff, 0x2f, 0x00,
+    };
+    static const byte notesA[] = {
+        0x83, 0x60, 0x91, 60, 100,      // 480: 500 ms
+        0x83, 0x60, 0x81, 60, 0,        // 960: 750 ms
+        0x00, 0xff, 0x2f, 0x00,
+    };
+    static const byte notesB[] = {
+        0x81, 0x70, 0x92, 67, 90,       // 240: 250 ms
+        0x87, 0x40, 0x82, 67, 0,        // 1200: 875 ms
+        0x00, 0xff, 0x2f, 0x00,
+    };
+    Buffer file = makeHeader(1, 3, 480);
+    appendChunk(file, "MTrk", tempoTrack, sizeof(tempoTrack));
+    static const byte unknown[3] = { 1, 2, 3 };
+    appendChunk(file, "XFIH", unknown, 3);
+    appendChunk(file, "MTrk", notesA, sizeof(notesA));
+    appendChunk(file, "MTrk", notesB, sizeof(notesB));
+
+    SerialMock serial;
+    MidiInterface midi(serial);
+    midi.begin(MIDI_CHANNEL_OMNI);
+    midi::SmfMemorySource source(&file[0], file.size());
+    midi::SmfPlayer<MidiInterface, midi::SmfMemorySource, 4, 4> player(midi);
+
+    EXPECT_EQ(player.open(source), true);
+    EXPECT_EQ(player.getTrackCount(), 3u);
+    player.start(0);
+
+    // Meta events are due too, but send nothing.
+    EXPECT_EQ(player.service(0), 0u);
+
+    static const unsigned long times[4] = { 250000, 500000, 750000, 875000 };
+    static const byte messages[4][3] = {
+        { 0x92, 67, 90 }, { 0x91, 60, 100 }, { 0x81, 60, 0 }, { 0x82, 67, 0 },
+    };
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        unsigned long next = 0;
+        EXPECT_EQ(player.getNextTime(next), true);
+        EXPECT_EQ(next, times[i]);
+        EXPECT_EQ(player.service(times[i] - 1), 0u);
+        EXPECT_EQ(player.service(times[i]), 1u);
+        EXPECT_THAT(readTx(serial), ElementsAreArray(messages[i]));
+    }
+    EXPECT_EQ(player.isPlaying(), false);
+}
+
+TEST(SmfPlayer, sysExChunks)
+{
+    static const byte track[] = {
+        0x00, 0xf0, 0x05, 1, 2, 3, 4, 0xf7,     // Complete SysEx
+        0x00, 0xf7, 0x01, 0xf8,                 // Escaped Real Time
+        0x00, 0xff, 0x2f, 0x00,
+    };
+    Buffer file = makeHeader(0, 1, 96);
+    appendChunk(file, "MTrk", track, sizeof(track));
+
+    SerialMock serial;
+    MidiInterface midi(serial);
+    midi.begin(MIDI_CHANNEL_OMNI);
+    midi::SmfMemorySource source(&file[0], file.size());
+    midi::SmfPlayer<MidiInterface, midi::SmfMemorySource, 1, 4> player(midi);
+
+    EXPECT_EQ(player.open(source), true);
+    player.start(0);
+    EXPECT_EQ(player.service(0), 2u);
+
+    static const byte sent[7] = { 0xf0, 1, 2, 3, 4, 0xf7, 0xf8 };
+    EXPECT_THAT(readTx(serial), ElementsAreArray(sent));
+    EXPECT_EQ(player.isPlaying(), false);
+}
+
+TEST(SmfPlayer, smpteTimeDivision)
+{
+    static const byte track[] = {
+        0x00, 0xff, 0x51, 0x03, 0x07, 0xa1, 0x20,   // Ignored with SMPTE
+        0x64, 0x90, 60, 100,                        // 100 ticks
+        0x00, 0xff, 0x2f, 0x00,
+    };
+    // 25 frames per second, 40 ticks per frame: 1 ms per tick.
+    Buffer file = makeHeader(0, 1, ((256 - 25) << 8) | 40);
+    appendChunk(file, "MTrk", track, sizeof(track));
+
+    SerialMock serial;
+    MidiInterface midi(serial);
+    midi.begin(MIDI_CHANNEL_OMNI);
+    midi::SmfMemorySource source(&file[0], file.size());
+    SmfPlayer player(midi);
+
+    EXPECT_EQ(player.open(source), true);
+    player.start(0);
+    EXPECT_EQ(player.service(0), 0u);
+
+    unsigned long next = 0;
+    EXPECT_EQ(player.getNextTime(next), true);
+    EXPECT_EQ(next, 100000ul);
+    EXPECT_EQ(player.service(100000), 1u);
+}
+
+TEST(SmfPlayer, invalidFiles)
+{
+    SerialMock serial;
+    MidiInterface midi(serial);
+    midi::SmfPlayer<MidiInterface, midi::SmfMemorySource, 2> player(midi);
+    static const byte track[4] = { 0x00, 0xff, 0x2f, 0x00 };
+
+    Buffer formatTwo = makeHeader(2, 1, 96);
+    appendChunk(formatTwo, "MTrk", track, 4);
+    midi::SmfMemorySource formatTwoSource(&formatTwo[0], formatTwo.size());
+    EXPECT_EQ(player.open(formatTwoSource), false);
+
+    Buffer tooManyTracks = makeHeader(1, 3, 96);
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        appendChunk(tooManyTracks, "MTrk", track, 4);
+    }
+    midi::SmfMemorySource tooManyTracksSource(&tooManyTracks[0], tooManyTracks.size());
+    EXPECT_EQ(player.open(tooManyTracksSource), false);
+
+    Buffer truncated = makeHeader(0, 1, 96);
+    truncated.resize(10);
+    midi::SmfMemorySource truncatedSource(&truncated[0], truncated.size());
+    EXPECT_EQ(player.open(truncatedSource), false);
+
+    // Data byte without Running Status: the track ends there.
+    static const byte noStatus[4] = { 0x00, 60, 100, 0x00 };
+    Buffer file = makeHeader(0, 1, 96);
+    appendChunk(file, "MTrk", noStatus, 4);
+    midi::SmfMemorySource source(&file[0], file.size());
+    EXPECT_EQ(player.open(source), true);
+    player.start(0);
+    EXPECT_EQ(player.isPlaying(), false);
+    EXPECT_EQ(player.service(0), 0u);
+}
+
+TEST(SmfPlayer, mappedFile)
+{
+    static const byte track[] = {
+        0x00, 0xc0, 7,
+        0x00, 0xff, 0x2f, 0x00,
+    };
+    Buffer file = makeHeader(0, 1, 96);
+    appendChunk(file, "MTrk", track, sizeof(track));
+
+    char path[] = "/tmp/unit-tests-smf-XXXXXX";
+    const int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    EXPECT_EQ(write(fd, &file[0], file.size()), ssize_t(file.size()));
+    close(fd);
+
+    SerialMock serial;
+    MidiInterface midi(serial);
+    midi.begin(MIDI_CHANNEL_OMNI);
+    midi::SmfMappedFile mapped;
+    midi::SmfPlayer<MidiInterface, midi::SmfMappedFile> player(midi);
+
+    EXPECT_EQ(mapped.open("/tmp/does-not-exist.mid"), false);
+    EXPECT_EQ(mapped.open(path), true);
+    unlink(path);
+    EXPECT_EQ(player.open(mapped), true);
+    player.start(0);
+    EXPECT_EQ(player.service(0), 1u);
+
+    static const byte programChange[2] = { 0xc0, 7 };
+    EXPECT_THAT(readTx(serial), ElementsAreArray(programChange));
+}
+
+END_UNNAMED_NAMESPACE
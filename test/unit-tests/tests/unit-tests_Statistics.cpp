@@ -0,0 +1,155 @@
+#include "unit-tests.h"
+#include <src/MIDI.h>
+#include <test/mocks/test-mocks_SerialMock.h>
+
+BEGIN_UNNAMED_NAMESPACE
+
+using namespace testing;
+USING_NAMESPACE_UNIT_TESTS
+typedef test_mocks::SerialMock<32> SerialMock;
+
+template<unsigned QueueSize, bool Timestamps>
+struct StatisticsSettings : midi::DefaultSettings
+{
+    static const bool UseStatistics = true;
+    static const bool UseReceiveTimestamps = Timestamps;
+    static const unsigned MessageQueueSize = QueueSize;
+    static const unsigned SysExMaxSize = 8;
+};
+
+struct ManualPlatform
+{
+    static unsigned long now()
+    {
+        return sTime;
+    }
+    static unsigned long sTime;
+};
+unsigned long ManualPlatform::sTime = 0;
+
+typedef midi::Statistics<true> Statistics;
+
+// -----------------------------------------------------------------------------
+
+TEST(Statistics, latencyBuckets)
+{
+    EXPECT_EQ(Statistics::getLatencyBucket(0),      0u);
+    EXPECT_EQ(Statistics::getLatencyBucket(1),      1u);
+    EXPECT_EQ(Statistics::getLatencyBucket(2),      2u);
+    EXPECT_EQ(Statistics::getLatencyBucket(3),      2u);
+    EXPECT_EQ(Statistics::getLatencyBucket(4),      3u);
+    EXPECT_EQ(Statistics::getLatencyBucket(16383),  14u);
+    EXPECT_EQ(Statistics::getLatencyBucket(16384),  15u);
+    EXPECT_EQ(Statistics::getLatencyBucket(~0ul),   15u);
+
+    Statistics statistics;
+    statistics.countLatency(5);
+    statistics.countLatency(7);
+    statistics.countLatency(1000000);
+    EXPECT_EQ(statistics.getLatencies(3),   2ul);
+    EXPECT_EQ(statistics.getLatencies(15),  1ul);
+    EXPECT_EQ(statistics.getLatencies(16),  0ul);
+
+    statistics.reset();
+    EXPECT_EQ(statistics.getLatencies(3),   0ul);
+}
+
+TEST(Statistics, countInput)
+{
+    typedef midi::MidiInterface<SerialMock, StatisticsSettings<0, false> > MidiInterface;
+    SerialMock serial;
+    MidiInterface midi(serial);
+    midi.begin(MIDI_CHANNEL_OMNI);
+
+    static const byte rxData[23] = {
+        0x90, 60, 100,                  // NoteOn
+        62, 100,                        // NoteOn, Running Status
+        0xb0, 7, 0xf8, 64,              // ControlChange, interleaved Clock
+        0xf9,                           // Undefined
+        0xf4,                           // Undefined
+        0x12,                           // No Running Status after 0xf4
+        0xf7,                           // EOX outside of a SysEx
+        0xf0, 1, 2, 3, 4, 5, 6, 7,      // Longer than SysExMaxSize
+        0xc0, 5,                        // ProgramChange
+    };
+    EXPECT_EQ(midi.feed(rxData, 23), true);
+
+    const MidiInterface::MidiStatistics statistics = midi.getStatistics();
+    EXPECT_EQ(statistics.getBytes(),                        23ul);
+    EXPECT_EQ(statistics.getMessages(),                     5ul);
+    EXPECT_EQ(statistics.getMessages(midi::NoteOn),         2ul);
+    EXPECT_EQ(statistics.getMessages(midi::ControlChange),  1ul);
+    EXPECT_EQ(statistics.getMessages(midi::Clock),          1ul);
+    EXPECT_EQ(statistics.getMessages(midi::ProgramChange),  1ul);
+    EXPECT_EQ(statistics.getMessages(midi::SystemExclusive), 0ul);
+    EXPECT_EQ(statistics.getInvalidStatusBytes(),           3ul);
+    EXPECT_EQ(statistics.getStrayDataBytes(),               1ul);
+    EXPECT_EQ(statistics.getSysExOverflows(),               1ul);
+    EXPECT_EQ(statistics.getQueueOverruns(),                0ul);
+    EXPECT_EQ(statistics.getLatencies(0),                   0ul);
+
+    midi.resetStatistics();
+    EXPECT_EQ(midi.getStatistics().getBytes(),              0ul);
+    EXPECT_EQ(midi.getStatistics().getMessages(),           0ul);
+}
+
+TEST(Statistics, countQueueOverruns)
+{
+    typedef midi::MidiInterface<SerialMock, StatisticsSettings<2, false> > MidiInterface;
+    SerialMock serial;
+    MidiInterface midi(serial);
+    midi.begin(MIDI_CHANNEL_OMNI);
+
+    static const byte rxData[8] = { 0xc0, 1, 2, 3, 4, 5, 6, 7 };
+    EXPECT_EQ(midi.feed(rxData, 8), false);
+    EXPECT_EQ(midi.getStatistics().getQueueOverruns(), 5ul);
+
+    // Dropped messages are not dispatched.
+    EXPECT_EQ(midi.readMessages(8), 2u);
+    EXPECT_EQ(midi.getStatistics().getMessages(midi::ProgramChange), 2ul);
+}
+
+TEST(Statistics, latencyHistogram)
+{
+    typedef midi::MidiInterface<SerialMock, StatisticsSettings<4, true>, ManualPlatform> MidiInterface;
+    SerialMock serial;
+    MidiInterface midi(serial);
+    midi.begin(MIDI_CHANNEL_OMNI);
+
+    // Measured from the first byte of each message.
+    static const byte rxData[5] = { 0x90, 60, 100, 0xc0, 5 };
+    ManualPlatform::sTime = 1000;
+    midi.feed(rxData, 2);
+    ManualPlatform::sTime = 1200;
+    midi.feed(rxData + 2, 3);
+    ManualPlatform::sTime = 1205;
+    EXPECT_EQ(midi.readMessages(2), 2u);
+
+    const MidiInterface::MidiStatistics statistics = midi.getStatistics();
+    EXPECT_EQ(statistics.getLatencies(3), 1ul); // 5
+    EXPECT_EQ(statistics.getLatencies(8), 1ul); // 205
+    EXPECT_EQ(statistics.getMessages(),   2ul);
+}
+
+TEST(Statistics, compiledOut)
+{
+    typedef midi::MidiInterface<SerialMock> MidiInterface;
+    SerialMock serial;
+    MidiInterface midi(serial);
+    midi.begin(MIDI_CHANNEL_OMNI);
+
+    static const byte rxData[4] = { 0x90, 60, 100, 0xf9 };
+    midi.feed(rxData, 4);
+
+    EXPECT_EQ(midi.getStatistics().getBytes(),              0ul);
+    EXPECT_EQ(midi.getStatistics().getMessages(),           0ul);
+    EXPECT_EQ(midi.getStatistics().getInvalidStatusBytes(), 0ul);
+
+    struct Probe : midi::Statistics<false>
+    {
+        int mValue;
+    };
+    EXPECT_EQ(sizeof(Probe), sizeof(int));
+}
+
+END_UNNAMED_NAMESPACE
@@ -0,0 +1,216 @@
+#include "unit-tests.h"
+#include <src/MIDI.h>
+#include <test/mocks/test-mocks_SerialMock.h>
+
+BEGIN_MIDI_NAMESPACE
+
+END_MIDI_NAMESPACE
+
+// -----------------------------------------------------------------------------
+
+BEGIN_UNNAMED_NAMESPACE
+
+using namespace testing;
+typedef test_mocks::SerialMock<32> SerialMock;
+
+struct SmallSysExSettings : midi::DefaultSettings
+{
+    static const unsigned SysExMaxSize = 4;
+};
+
+typedef midi::MidiInterface<SerialMock, SmallSysExSettings> MidiInterface;
+
+std::vector<byte> receivedSysEx;
+
+void handleSysEx(byte* inData, unsigned inSize)
+{
+    receivedSysEx.assign(inData, inData + inSize);
+}
+
+bool feed(MidiInterface& inMidi, const byte* inData, unsigned inSize)
+{
+    receivedSysEx.clear();
+    for (unsigned i = 0; i < inSize; ++i)
+    {
+        inMidi.feed(inData[i]);
+    }
+    return !receivedSysEx.empty();
+}
+
+TEST(MidiSysExPool, acquireAndRelease)
+{
+    midi::StaticSysExPool<16, 2> pool;
+    EXPECT_EQ(pool.getBlockSize(),  unsigned(16));
+    EXPECT_EQ(pool.getBlockCount(), unsigned(2));
+
+    byte* first  = pool.acquire();
+    byte* second = pool.acquire();
+    EXPECT_NE(first,  nullptr);
+    EXPECT_NE(second, nullptr);
+    EXPECT_EQ(second - first, 16);
+    EXPECT_EQ(pool.getBlocksInUse(), unsigned(2));
+
+    // Exhausted
+    EXPECT_EQ(pool.acquire(), nullptr);
+    EXPECT_EQ(pool.getExhaustionCount(), unsigned(1));
+
+    // Released blocks are reused
+    pool.release(first);
+    EXPECT_EQ(pool.getBlocksInUse(), unsigned(1));
+    EXPECT_EQ(pool.acquire(), first);
+
+    pool.release(first);
+    pool.release(second);
+    pool.release(second); // Ignored
+    EXPECT_EQ(pool.getBlocksInUse(),     unsigned(0));
+    EXPECT_EQ(pool.getPeakBlocksInUse(), unsigned(2));
+
+    pool.resetCounters();
+    EXPECT_EQ(pool.getPeakBlocksInUse(), unsigned(0));
+    EXPECT_EQ(pool.getExhaustionCount(), unsigned(0));
+}
+
+TEST(MidiSysExPool, sharedBetweenInterfaces)
+{
+    midi::StaticSysExPool<16, 1> pool;
+    SerialMock serial1;
+    SerialMock serial2;
+    MidiInterface midi1(serial1);
+    MidiInterface midi2(serial2);
+    midi1.begin(MIDI_CHANNEL_OMNI);
+    midi2.begin(MIDI_CHANNEL_OMNI);
+    midi1.turnThruOff();
+    midi2.turnThruOff();
+    midi1.setHandleSystemExclusive(handleSysEx);
+    midi2.setHandleSystemExclusive(handleSysEx);
+    midi1.setSysExPool(&pool);
+    midi2.setSysExPool(&pool);
+
+    // Larger than SysExMaxSize, received in the pool block
+    static const byte large[8] = { 0xf0, 1, 2, 3, 4, 5, 6, 0xf7 };
+    EXPECT_EQ(feed(midi1, large, 8), true);
+    EXPECT_THAT(receivedSysEx, ElementsAreArray(large));
+    EXPECT_EQ(midi1.getSysExArrayLength(), unsigned(8));
+    EXPECT_THAT(std::vector<byte>(midi1.getSysExArray(), midi1.getSysExArray() + 8),
+                ElementsAreArray(large));
+    EXPECT_EQ(pool.getBlocksInUse(), unsigned(1));
+
+    // The block is held by midi1: midi2 drops frames that do not fit its buffer
+    EXPECT_EQ(feed(midi2, large, 8), false);
+    EXPECT_EQ(pool.getExhaustionCount(), unsigned(1));
+
+    static const byte small[3] = { 0xf0, 42, 0xf7 };
+    EXPECT_EQ(feed(midi2, small, 3), true);
+    EXPECT_THAT(receivedSysEx, ElementsAreArray(small));
+    EXPECT_EQ(midi2.getSysExArrayLength(), unsigned(3));
+    EXPECT_THAT(std::vector<byte>(midi2.getSysExArray(), midi2.getSysExArray() + 3),
+                ElementsAreArray(small));
+    EXPECT_EQ(pool.getExhaustionCount(), unsigned(2));
+
+    // Next message on midi1 gives the block back
+    static const byte noteOn[3] = { 0x90, 12, 34 };
+    feed(midi1, noteOn, 3);
+    EXPECT_EQ(pool.getBlocksInUse(), unsigned(0));
+
+    EXPECT_EQ(feed(midi2, large, 8), true);
+    EXPECT_EQ(midi2.getSysExArrayLength(), unsigned(8));
+    EXPECT_EQ(pool.getBlocksInUse(), unsigned(1));
+
+    // Frames larger than a block are dropped
+    static const byte tooLarge[20] = {
+        0xf0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 0xf7
+    };
+    EXPECT_EQ(feed(midi2, tooLarge, 20), false);
+
+    midi2.setSysExPool(0);
+    EXPECT_EQ(pool.getBlocksInUse(), unsigned(0));
+    EXPECT_EQ(pool.getPeakBlocksInUse(), unsigned(1));
+}
+
+TEST(MidiSysExPool, idlePortGivesBlockBack)
+{
+    midi::StaticSysExPool<16, 1> pool;
+    SerialMock serial1;
+    SerialMock serial2;
+    MidiInterface midi1(serial1);
+    MidiInterface midi2(serial2);
+    midi1.begin(MIDI_CHANNEL_OMNI);
+    midi2.begin(MIDI_CHANNEL_OMNI);
+    midi1.turnThruOff();
+    midi2.turnThruOff();
+    midi1.setSysExPool(&pool);
+    midi2.setSysExPool(&pool);
+
+    static const byte large[8] = { 0xf0, 1, 2, 3, 4, 5, 6, 0xf7 };
+    serial1.mRxBuffer.write(large, 8);
+    EXPECT_EQ(midi1.readMessages(4), unsigned(1));
+    EXPECT_EQ(midi1.getSysExArrayLength(), unsigned(8));
+    EXPECT_EQ(pool.getBlocksInUse(), unsigned(1));
+
+    // Still valid while midi1 is not read again
+    midi2.read();
+    EXPECT_THAT(std::vector<byte>(midi1.getSysExArray(), midi1.getSysExArray() + 8),
+                ElementsAreArray(large));
+
+    // Reading midi1 gives the block back, even when nothing was received
+    EXPECT_EQ(midi1.read(), false);
+    EXPECT_EQ(pool.getBlocksInUse(), unsigned(0));
+
+    serial2.mRxBuffer.write(large, 8);
+    EXPECT_EQ(midi2.readMessages(4), unsigned(1));
+    EXPECT_EQ(midi2.getSysExArrayLength(), unsigned(8));
+    EXPECT_EQ(pool.getExhaustionCount(), unsigned(0));
+
+    // A frame being received keeps its block
+    serial2.mRxBuffer.write(large, 4);
+    EXPECT_EQ(midi2.readMessages(4), unsigned(0));
+    EXPECT_EQ(pool.getBlocksInUse(), unsigned(1));
+    serial2.mRxBuffer.write(large + 4, 4);
+    EXPECT_EQ(midi2.readMessages(4), unsigned(1));
+    EXPECT_EQ(midi2.getSysExArrayLength(), unsigned(8));
+    EXPECT_EQ(midi2.readMessages(4), unsigned(0));
+    EXPECT_EQ(pool.getBlocksInUse(), unsigned(0));
+}
+
+TEST(MidiSysExPool, changingPoolKeepsLastMessage)
+{
+    midi::StaticSysExPool<16, 1> pool;
+    midi::StaticSysExPool<16, 1> otherPool;
+    SerialMock serial;
+    MidiInterface midi(serial);
+    midi.begin(MIDI_CHANNEL_OMNI);
+    midi.turnThruOff();
+    midi.setSysExPool(&pool);
+
+    static const byte large[8] = { 0xf0, 1, 2, 3, 4, 5, 6, 0xf7 };
+    serial.mRxBuffer.write(large, 8);
+    EXPECT_EQ(midi.readMessages(4), unsigned(1));
+    EXPECT_EQ(pool.getBlocksInUse(), unsigned(1));
+
+    // The last message still uses its block
+    midi.setSysExPool(&otherPool);
+    EXPECT_EQ(pool.getBlocksInUse(), unsigned(1));
+    EXPECT_THAT(std::vector<byte>(midi.getSysExArray(), midi.getSysExArray() + 8),
+                ElementsAreArray(large));
+
+    // Given back to the pool it came from
+    EXPECT_EQ(midi.read(), false);
+    EXPECT_EQ(pool.getBlocksInUse(), unsigned(0));
+
+    serial.mRxBuffer.write(large, 8);
+    EXPECT_EQ(midi.readMessages(4), unsigned(1));
+    EXPECT_EQ(otherPool.getBlocksInUse(), unsigned(1));
+    EXPECT_EQ(pool.getBlocksInUse(), unsigned(0));
+
+    // A frame being received is dropped with its block
+    midi.read();
+    serial.mRxBuffer.write(large, 4);
+    EXPECT_EQ(midi.readMessages(4), unsigned(0));
+    EXPECT_EQ(otherPool.getBlocksInUse(), unsigned(1));
+    midi.setSysExPool(0);
+    EXPECT_EQ(otherPool.getBlocksInUse(), unsigned(0));
+    serial.mRxBuffer.write(large + 4, 4);
+    EXPECT_EQ(midi.readMessages(4), unsigned(0));
+}
+
+END_UNNAMED_NAMESPACE